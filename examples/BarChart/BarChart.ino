@@ -4,7 +4,7 @@
 TFT_eSPI tft = TFT_eSPI();  
 
 // BarChart instance
-String names[] = {"BTC", "ETH", "ADA", "XRP", "DOGE"};
+const char *names[] = {"BTC", "ETH", "ADA", "XRP", "DOGE"};
 uint16_t colors[] = {TFT_GREEN, TFT_BLUE, TFT_CYAN, TFT_YELLOW, TFT_RED};
 BarChart barChart(&tft, 20, 20, 280, 200, "Crypto Market",
                   LEGEND_BOTTOM, 5, names, colors, TFT_BLACK);
@@ -10,9 +10,9 @@ uint16_t COLORS[] = {
   tft.color565(171, 71, 188)    // Roxo
 };
 
-String lineNames[] = {"Temp °C","Hum %"};
-String barNames[]  = {"ON","OFF","ALERT"};
-String pieNames[]  = {"Solar","Grid","Battery"};
+const char *lineNames[] = {"Temp °C","Hum %"};
+const char *barNames[] = {"ON","OFF","ALERT"};
+const char *pieNames[] = {"Solar","Grid","Battery"};
 
 // since we added gauge support, we'll show moisture as a circular widget
 Gauge moistureGauge(&tft, 120, 60, 50, tft.color565(30,30,30), COLORS[1]);
@@ -36,8 +36,12 @@ void drawMiniWidget(float temp, float hum) {
   tft.setTextSize(1);
   tft.setTextColor(TFT_WHITE, tft.color565(50,50,50));
 
-  tft.drawString("T: " + String(temp,1) + "C", x0+5, y0+16);
-  tft.drawString("H: " + String(hum,1) + "%", x0+5, y0+40);
+  // format into stack buffers so the loop never touches the heap
+  char num[8], line[16];
+  snprintf(line, sizeof(line), "T: %sC", dtostrf(temp, 1, 1, num));
+  tft.drawString(line, x0+5, y0+16);
+  snprintf(line, sizeof(line), "H: %s%%", dtostrf(hum, 1, 1, num));
+  tft.drawString(line, x0+5, y0+40);
 }
 
 void setup() {
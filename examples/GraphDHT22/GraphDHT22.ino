@@ -9,17 +9,22 @@
 TFT_eSPI tft = TFT_eSPI();
 DHT dht(DHTPIN, DHTTYPE);
 
-String names[2] = {"Temperature", "Humidity"}; 
+const char *names[2] = {"Temperature", "Humidity"}; 
 uint16_t colors[2] = {TFT_YELLOW, TFT_BLUE};
 
 Graph g(&tft, 20, 20, 280, 200, 0, 100, "DHT22 Graph", LEGEND_BOTTOM, 2, names, colors);
 
+// readings come every 30 s; show the last 2 hours and break the line when
+// three or more readings in a row are missing
+TimedSample history[512];
+
 void setup() {
     Serial.begin(115200);
     tft.init();
     tft.setRotation(1);
     tft.fillScreen(TFT_GREY);
     g.resetGraph();
+    g.setTimeWindow(history, 512, 2UL * 60 * 60 * 1000, 3 * 30000UL);
     dht.begin();
 }
 
@@ -30,10 +35,12 @@ void loop() {
     if (isnan(temp) || isnan(hum)) {
         Serial.println("Falha ao ler o DHT22!");
     } else {
-        g.plotPoint(0, temp);
-        g.plotPoint(1, hum);
-        g.nextX();
+        uint32_t now = millis();
+        g.plotPoint(0, temp, now);
+        g.plotPoint(1, hum, now);
     }
+    // the time axis keeps moving even when a reading fails
+    g.updateTime(millis());
 
     delay(30000);
 }
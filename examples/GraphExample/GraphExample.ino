@@ -5,7 +5,7 @@
 
 TFT_eSPI tft = TFT_eSPI();
 
-String names[3] = {"Sensor A", "Sensor B", "Sensor C"}; 
+const char *names[3] = {"Sensor A", "Sensor B", "Sensor C"}; 
 uint16_t colors[3] = {TFT_GREEN, TFT_RED, TFT_BLUE};
 
 Graph g(&tft, 20, 20, 280, 200, 0, 100, "Test Graph", LEGEND_BOTTOM, 3, names, colors);
@@ -3,7 +3,7 @@
 
 TFT_eSPI tft = TFT_eSPI();
 
-String labels[4] = {"Apples", "Bananas", "Cherries", "Dates"};
+const char *labels[4] = {"Apples", "Bananas", "Cherries", "Dates"};
 uint16_t colors[4] = {TFT_RED, TFT_YELLOW, TFT_GREEN, TFT_BLUE};
 
 // x, y, width, height totais (inclui título e legenda)
@@ -0,0 +1,39 @@
+#include <TFT_eSPI.h>
+#include <GraphTFT.h>
+
+#define COLS 6
+#define ROWS 5
+#define CELLS (COLS * ROWS)
+
+TFT_eSPI tft = TFT_eSPI();
+Sparkline *cells[CELLS];
+
+void setup() {
+    tft.init();
+    tft.setRotation(1); // landscape
+    tft.fillScreen(TFT_BLACK);
+
+    // 30 small trend cells filling a 320x240 screen
+    int cellW = 320 / COLS;
+    int cellH = 240 / ROWS;
+    for (int i = 0; i < CELLS; i++) {
+        int x = (i % COLS) * cellW;
+        int y = (i / COLS) * cellH;
+        cells[i] = new Sparkline(&tft, x + 1, y + 1, cellW - 2, cellH - 2,
+                                 0, 100, "", TFT_GREEN, TFT_BLACK, TFT_DARKGREY);
+        cells[i]->showMinMax(true);
+        cells[i]->draw();
+    }
+}
+
+void loop() {
+    static int t = 0;
+    float values[CELLS];
+    for (int i = 0; i < CELLS; i++)
+        values[i] = 50 + 40 * sin((t + i * 7) * 0.2) + random(-5, 6);
+
+    // one transaction per cell for the whole grid
+    Sparkline::updateAll(cells, values, CELLS);
+    t++;
+    delay(500);
+}
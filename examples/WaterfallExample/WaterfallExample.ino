@@ -0,0 +1,32 @@
+#include <TFT_eSPI.h>
+#include <GraphTFT.h>
+
+#define BINS 64
+
+TFT_eSPI tft = TFT_eSPI();
+
+// 64 simulated spectrum bins, values 0..100
+Waterfall wf(&tft, 10, 10, 300, 220, 0, 100, BINS, "Spectrum");
+
+void setup() {
+    tft.init();
+    tft.setRotation(1); // landscape
+    tft.fillScreen(TFT_BLACK);
+    wf.resetWaterfall();
+}
+
+void loop() {
+    static float t = 0;
+    float bins[BINS];
+
+    // a peak drifting across the spectrum over a noise floor
+    float peak = (sin(t) * 0.5f + 0.5f) * (BINS - 1);
+    for (int i = 0; i < BINS; i++) {
+        float d = i - peak;
+        bins[i] = 100.0f * exp(-d * d / 18.0f) + random(0, 15);
+    }
+
+    wf.pushRow(bins);
+    t += 0.05f;
+    delay(20);
+}
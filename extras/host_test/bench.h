@@ -0,0 +1,48 @@
+// Shared helpers for the host benchmarks: wall-clock timing of the CPU side
+// and an estimate of the SPI time from the stub's bus counters.
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <TFT_eSPI.h>
+#include <chrono>
+#include <stdio.h>
+
+// SPI clock the bus estimate assumes (TFT_eSPI's usual ESP32 setting)
+#ifndef BENCH_SPI_MHZ
+#define BENCH_SPI_MHZ 40
+#endif
+
+// CS toggle, SPI setup and DC switching per transaction
+#ifndef BENCH_TRANSACTION_US
+#define BENCH_TRANSACTION_US 1.0
+#endif
+
+class BenchTimer {
+public:
+    BenchTimer() : start(std::chrono::steady_clock::now()) {}
+    double ms() const {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+inline double busMs(const BusStats &s) {
+    return s.busBytes * 8.0 / (BENCH_SPI_MHZ * 1000.0) +
+           s.transactions * BENCH_TRANSACTION_US / 1000.0;
+}
+
+inline void printBusHeader() {
+    printf("%-28s %10s %10s %10s %10s %10s\n",
+           "", "trans", "windows", "px read", "bus ms", "cpu ms");
+}
+
+// one row of counters, averaged over `per` repetitions
+inline void printBus(const char *label, const BusStats &s, double cpuMs, int per = 1) {
+    printf("%-28s %10ld %10ld %10ld %10.2f %10.3f\n",
+           label, s.transactions / per, s.windows / per, s.pixelsRead / per,
+           busMs(s) / per, cpuMs / per);
+}
+
+#endif
@@ -0,0 +1,131 @@
+// IndexedCanvas against an RGB565 sprite for a 280x200 plot: heap held by
+// each, and the cost of pushing it (palette expansion in CANVAS_PUSH_PIXELS
+// chunks vs one pushColors of ready-made RGB565).
+//
+// Fails if a 4/8 bpp canvas holds more than a quarter/half of the RGB565
+// buffer (plus its palette), or if its push differs from the RGB565 one on
+// the panel or on the bus.
+#include <GraphTFT.h>
+#include "bench.h"
+#include <malloc.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+static const int W = 280, H = 200;
+static const int PUSHES = 200;
+
+static long heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return (long)mallinfo2().uordblks;
+#else
+    return (long)mallinfo().uordblks;
+#endif
+}
+
+// what a scrolled Graph composes: border, three series and their AA ramps
+static void drawPlot(IndexedCanvas &c) {
+    uint16_t colours[] = {TFT_RED, TFT_GREEN, TFT_YELLOW};
+    c.clear(TFT_BLACK);
+    c.drawAALine(0, 0, W - 1, 0, TFT_WHITE);
+    c.drawAALine(W - 1, 0, W - 1, H - 1, TFT_WHITE);
+    c.drawAALine(W - 1, H - 1, 0, H - 1, TFT_WHITE);
+    c.drawAALine(0, H - 1, 0, 0, TFT_WHITE);
+    for (int s = 0; s < 3; s++) {
+        int prev = H / 2;
+        for (int x = 1; x < W; x++) {
+            int y = H / 2 + (int)((H / 2 - 4) * sinf(x * (0.03f + 0.02f * s) + s));
+            c.drawAALine(x - 1, prev, x, y, colours[s]);
+            prev = y;
+        }
+    }
+}
+
+struct Result {
+    long heap;
+    BusStats bus;
+    double cpuMs;
+};
+
+static Result pushRGB565(TFT_eSPI &tft, const IndexedCanvas &src) {
+    Result r;
+    long before = heapInUse();
+    std::vector<uint16_t> sprite(W * H);
+    r.heap = heapInUse() - before;
+    for (int j = 0; j < H; j++)
+        for (int i = 0; i < W; i++) sprite[j * W + i] = src.readPixel(i, j);
+
+    tft.resetStats();
+    BenchTimer t;
+    for (int k = 0; k < PUSHES; k++) {
+        tft.startWrite();
+        tft.setAddrWindow(20, 20, W, H);
+        tft.pushColors(sprite.data(), W * H);
+        tft.endWrite();
+    }
+    r.cpuMs = t.ms();
+    r.bus = tft.stats;
+    return r;
+}
+
+static Result pushCanvas(TFT_eSPI &tft, IndexedCanvas &c, long heap) {
+    Result r;
+    r.heap = heap;
+    tft.resetStats();
+    BenchTimer t;
+    for (int k = 0; k < PUSHES; k++) c.push(&tft, 20, 20);
+    r.cpuMs = t.ms();
+    r.bus = tft.stats;
+    return r;
+}
+
+static void report(const char *label, const Result &r, const Result &ref) {
+    printf("%-14s %10ld %9.0f%% %10ld %10.2f %10.3f %9.0f%%\n", label, r.heap,
+           100.0 * r.heap / ref.heap, r.bus.transactions / PUSHES,
+           busMs(r.bus) / PUSHES, r.cpuMs / PUSHES,
+           100.0 * (r.cpuMs - ref.cpuMs) / ref.cpuMs);
+}
+
+int main() {
+    bool ok = true;
+    printf("%dx%d plot, %d pushes (bus at %d MHz)\n", W, H, PUSHES, BENCH_SPI_MHZ);
+    printf("%-14s %10s %10s %10s %10s %10s %10s\n", "", "heap B", "of 565",
+           "trans", "bus ms", "cpu ms", "cpu +");
+
+    long before = heapInUse();
+    IndexedCanvas c8(W, H, 8);
+    long heap8 = heapInUse() - before;
+    before = heapInUse();
+    IndexedCanvas c4(W, H, 4);
+    long heap4 = heapInUse() - before;
+    drawPlot(c8);
+    drawPlot(c4);
+
+    TFT_eSPI ref, tft;
+    Result r565 = pushRGB565(ref, c8);
+    Result r8 = pushCanvas(tft, c8, heap8);
+    bool same8 = ref.fb == tft.fb;
+    report("RGB565", r565, r565);
+    report("8 bpp", r8, r565);
+
+    TFT_eSPI ref4, tft4;
+    Result r565b = pushRGB565(ref4, c4);
+    Result r4 = pushCanvas(tft4, c4, heap4);
+    bool same4 = ref4.fb == tft4.fb;
+    report("4 bpp", r4, r565b);
+
+    if (r8.heap > r565.heap / 2 + 1024 || r4.heap > r565.heap / 4 + 1024) {
+        puts("FAIL: canvas holds more than its share of an RGB565 buffer");
+        ok = false;
+    }
+    if (!same8 || !same4) {
+        puts("FAIL: canvas push differs from the RGB565 push on the panel");
+        ok = false;
+    }
+    if (r8.bus.busBytes != r565.bus.busBytes || r4.bus.busBytes != r565b.bus.busBytes) {
+        puts("FAIL: canvas push sends more than the RGB565 push");
+        ok = false;
+    }
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// Graph::plotFrame against one plotPoint per series, for 1 to 8 series
+// (built with GRAPH_MAX_SERIES=8): cost per update (values + nextX) while
+// the plot fills and once it scrolls.
+//
+// Fails if plotFrame needs more transactions than plotPoint, if a column
+// takes more than one window while filling, or if the box's side edges are
+// lost where no series crosses them.
+#include <GraphTFT.h>
+#include "bench.h"
+#include <math.h>
+
+static const int SCROLLS = 100;
+
+// Graph's default margins put the plot at (20, 20)
+static const int PLOT_X = 20, PLOT_Y = 20;
+
+static int value(int series, int i) {
+    return 50 + (int)(40 * sinf(i * (0.04f + 0.01f * series) + series));
+}
+
+struct Result {
+    BusStats fill, scroll;
+    double fillMs, scrollMs;
+    int fillN;
+    long edgeGaps;   // background pixels left on the box's side edges
+};
+
+static Result run(int series, bool frame) {
+    static uint16_t palette[] = {TFT_RED, TFT_GREEN, TFT_YELLOW, TFT_CYAN,
+                                 TFT_MAGENTA, TFT_ORANGE, TFT_BLUE, TFT_PINK};
+    TFT_eSPI tft;
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Series", LEGEND_BOTTOM, series, nullptr, palette);
+
+    Result r;
+    r.fillN = g.plotWidth() - 1;
+    int values[GRAPH_MAX_SERIES];
+    for (int phase = 0; phase < 2; phase++) {
+        int n = phase ? SCROLLS : r.fillN;
+        tft.resetStats();
+        BenchTimer t;
+        for (int i = 0; i < n; i++) {
+            int k = phase * r.fillN + i;
+            for (int s = 0; s < series; s++) values[s] = value(s, k);
+            if (frame) g.plotFrame(values);
+            else for (int s = 0; s < series; s++) g.plotPoint(s, values[s]);
+            g.nextX();
+        }
+        (phase ? r.scrollMs : r.fillMs) = t.ms();
+        (phase ? r.scroll : r.fill) = tft.stats;
+    }
+
+    r.edgeGaps = 0;
+    int right = PLOT_X + g.plotWidth() - 1;
+    for (int y = PLOT_Y; y < PLOT_Y + g.plotHeight(); y++)
+        r.edgeGaps += (tft.pixel(PLOT_X, y) == TFT_BLACK) + (tft.pixel(right, y) == TFT_BLACK);
+    return r;
+}
+
+int main() {
+    bool ok = true;
+    printf("GRAPH_MAX_SERIES %d, sizeof(Graph) %zu B\n", GRAPH_MAX_SERIES, sizeof(Graph));
+    printBusHeader();
+    for (int series = 1; series <= 8; series++) {
+        Result point = run(series, false), frame = run(series, true);
+        char label[48];
+        snprintf(label, sizeof(label), "%d plotPoint, filling", series);
+        printBus(label, point.fill, point.fillMs, point.fillN);
+        snprintf(label, sizeof(label), "%d plotFrame, filling", series);
+        printBus(label, frame.fill, frame.fillMs, frame.fillN);
+        snprintf(label, sizeof(label), "%d plotPoint, scrolling", series);
+        printBus(label, point.scroll, point.scrollMs, SCROLLS);
+        snprintf(label, sizeof(label), "%d plotFrame, scrolling", series);
+        printBus(label, frame.scroll, frame.scrollMs, SCROLLS);
+
+        if (frame.fill.transactions > point.fill.transactions ||
+            frame.scroll.transactions > point.scroll.transactions) {
+            printf("FAIL: plotFrame needs more transactions than plotPoint (%d series)\n", series);
+            ok = false;
+        }
+        if (frame.fill.windows != frame.fillN) {
+            printf("FAIL: plotFrame column takes more than one window (%d series)\n", series);
+            ok = false;
+        }
+        if (frame.edgeGaps > 0) {
+            printf("FAIL: plotFrame left %ld gaps in the box edges (%d series)\n",
+                   frame.edgeGaps, series);
+            ok = false;
+        }
+    }
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
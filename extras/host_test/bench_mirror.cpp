@@ -0,0 +1,286 @@
+// FrameMirror bandwidth on the DashboardExample loop, and a check that what
+// the host decodes is exactly what the panel shows after every frame.
+//
+// Also runs the other widgets (overlays, plotFrame, canvas, waterfall,
+// sparklines, bars) through the same check, since each copies pixels its
+// own way, and a scrolling graph whose readings touch yMin, whose two
+// series cross on steep lines and are sometimes plotted out of order or
+// twice: a mirrored scroll must reproduce each exactly. Last, what a
+// PieChart and a Gauge cost to draw with no mirror at all.
+#include "dashboard.h"
+#include "bench.h"
+#include <vector>
+
+static const int FRAMES = 400;
+static const double BAUD = 115200;
+static const double LOOP_S = 1.2;   // DashboardExample's delay()
+
+// collects what FrameMirror writes, frame by frame
+struct Capture : Stream {
+    std::vector<uint8_t> bytes;
+    size_t write(uint8_t c) override { bytes.push_back(c); return 1; }
+};
+
+// the host side: applies ops to its own copy of the screen
+// (same rules as extras/mirror_decode.py)
+struct HostScreen {
+    int W, H;
+    std::vector<uint16_t> fb;
+    int wx = 0, wy = 0, ww = 0, wh = 0;
+    long cursor = 0;
+    size_t pos = 0;
+
+    HostScreen(int w, int h) : W(w), H(h), fb(w * h, 0) {}
+
+    static int u16(const std::vector<uint8_t> &b, size_t i) { return b[i] | (b[i + 1] << 8); }
+
+    void put(int x, int y, uint16_t c) {
+        if (x >= 0 && y >= 0 && x < W && y < H) fb[y * W + x] = c;
+    }
+
+    // returns false on a malformed stream
+    bool apply(const std::vector<uint8_t> &b) {
+        while (pos < b.size()) {
+            if (b.size() - pos < 4 || b[pos] != 'G' || b[pos + 1] != 'F') return false;
+            int ops = u16(b, pos + 2);
+            pos += 4;
+            for (int k = 0; k < ops; k++) {
+                char op = b[pos++];
+                if (op == 'W') {
+                    wx = u16(b, pos); wy = u16(b, pos + 2);
+                    ww = u16(b, pos + 4); wh = u16(b, pos + 6);
+                    cursor = 0;
+                    pos += 8;
+                } else if (op == 'D') {
+                    int runs = u16(b, pos);
+                    pos += 2;
+                    for (int r = 0; r < runs; r++, pos += 3) {
+                        int n = b[pos];
+                        uint16_t c = u16(b, pos + 1);
+                        for (int i = 0; i < n; i++) {
+                            put(wx + cursor % ww, wy + cursor / ww, c);
+                            cursor = (cursor + 1) % ((long)ww * wh);
+                        }
+                    }
+                } else if (op == 'F' || op == 'S') {
+                    int x = u16(b, pos), y = u16(b, pos + 2);
+                    int w = u16(b, pos + 4), h = u16(b, pos + 6);
+                    int v = u16(b, pos + 8);
+                    pos += 10;
+                    if (op == 'F') {
+                        for (int j = y; j < y + h; j++)
+                            for (int i = x; i < x + w; i++) put(i, j, v);
+                    } else {
+                        int dx = (int16_t)v;
+                        for (int j = y; j < y + h && j < H; j++) {
+                            uint16_t *row = &fb[j * W];
+                            if (dx < 0)
+                                for (int i = x; i < x + w + dx; i++) row[i] = row[i - dx];
+                            else
+                                for (int i = x + w - 1; i >= x + dx; i--) row[i] = row[i - dx];
+                        }
+                    }
+                } else {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    long mismatches(const TFT_eSPI &tft) const {
+        long n = 0;
+        for (size_t i = 0; i < fb.size(); i++) n += fb[i] != tft.fb[i];
+        return n;
+    }
+};
+
+struct FrameLog {
+    long frames = 0, bytes = 0, maxBytes = 0, bad = 0, pixelsRead = 0;
+    bool malformed = false;
+};
+
+static void endFrame(FrameMirror &mirror, Capture &cap, HostScreen &host,
+                     TFT_eSPI &tft, FrameLog &log) {
+    size_t before = cap.bytes.size();
+    long readBefore = tft.stats.pixelsRead;
+    mirror.sendFrame();
+    long n = (long)(cap.bytes.size() - before);
+    log.frames++;
+    log.bytes += n;
+    log.maxBytes = max(log.maxBytes, n);
+    log.pixelsRead += tft.stats.pixelsRead - readBefore;
+    if (!host.apply(cap.bytes)) log.malformed = true;
+    if (host.mismatches(tft)) log.bad++;
+}
+
+static void report(const char *label, const FrameLog &log) {
+    double avg = (double)log.bytes / log.frames;
+    printf("%-26s %9.0f %9ld %9.3f %9.3f %9ld %9ld\n", label, avg, log.maxBytes,
+           avg * 10 / BAUD, log.maxBytes * 10 / BAUD,
+           log.pixelsRead / log.frames, log.bad);
+}
+
+static bool dashboard() {
+    TFT_eSPI tft;
+    Capture cap;
+    HostScreen host(tft.width(), tft.height());
+    FrameMirror mirror(&tft, cap);
+    FrameLog first, loop;
+
+    mirror.begin();
+    Dashboard dash(tft);
+    dash.setup();
+    endFrame(mirror, cap, host, tft, first);
+    for (int i = 0; i < FRAMES; i++) {
+        dash.loop();
+        mirror.markDirty(250, 20, 65, 65);   // the mini widget is drawn directly
+        endFrame(mirror, cap, host, tft, loop);
+    }
+
+    report("dashboard, first frame", first);
+    report("dashboard, per loop", loop);
+    double avgS = (double)loop.bytes / loop.frames * 10 / BAUD;
+    if (first.malformed || loop.malformed || first.bad || loop.bad) {
+        puts("FAIL: host copy differs from the panel");
+        return false;
+    }
+    if (avgS > LOOP_S) {
+        puts("FAIL: a loop's worth of updates doesn't fit the loop at 115200 baud");
+        return false;
+    }
+    return true;
+}
+
+static bool otherWidgets() {
+    TFT_eSPI tft;
+    Capture cap;
+    HostScreen host(tft.width(), tft.height());
+    FrameMirror mirror(&tft, cap);
+    FrameLog log;
+    mirror.begin();
+
+    const char *names[] = {"A", "B", "C"};
+    uint16_t colors[] = {TFT_RED, TFT_GREEN, TFT_YELLOW};
+    Graph overlays(&tft, 0, 0, 160, 80, 0, 100, "Overlays", LEGEND_RIGHT, 3, names, colors);
+    overlays.setOverlay(0, STAT_EMA, 0.2f);
+    overlays.setOverlay(1, STAT_MEAN, 8);
+    overlays.setOverlay(2, STAT_BAND);
+    Graph frame(&tft, 160, 0, 160, 80, 0, 100, "Frame", LEGEND_RIGHT, 2, names, colors);
+    Graph withCanvas(&tft, 0, 80, 160, 80, 0, 100, "Canvas", LEGEND_RIGHT, 2, names, colors);
+    IndexedCanvas canvas(withCanvas.plotWidth(), withCanvas.plotHeight(), 4);
+    withCanvas.setCanvas(&canvas);
+    Waterfall wf(&tft, 160, 80, 160, 80, 0, 100, 24, "FFT");
+    Sparkline s0(&tft, 0, 160, 80, 80, 0, 100, "T");
+    Sparkline s1(&tft, 80, 160, 80, 80, 0, 100);
+    s1.showMinMax(true);
+    Sparkline *grid[] = {&s0, &s1};
+    BarChart bars(&tft, 160, 160, 160, 80, "Bars", LEGEND_BOTTOM, 3, names, colors);
+    endFrame(mirror, cap, host, tft, log);
+
+    for (int i = 0; i < FRAMES; i++) {
+        int v = 50 + (int)(40 * sinf(i * 0.13f));
+        int w = 50 + (int)(30 * cosf(i * 0.07f));
+        overlays.plotPoint(0, v);
+        overlays.plotPoint(1, w);
+        overlays.plotPoint(2, (v + w) / 2);
+        overlays.nextX();
+        int fv[] = {v, w};
+        frame.plotFrame(fv);
+        frame.nextX();
+        withCanvas.plotPoint(0, v);
+        withCanvas.plotPoint(1, w);
+        withCanvas.nextX();
+        float row[24];
+        for (int k = 0; k < 24; k++) row[k] = (float)((k * 7 + i * 3) % 100);
+        wf.pushRow(row);
+        float sv[] = {(float)v, (float)w};
+        Sparkline::updateAll(grid, sv, 2);
+        float bv[] = {(float)v, (float)w, 25.0f};
+        bars.setData(bv);
+        bars.draw();
+        endFrame(mirror, cap, host, tft, log);
+    }
+
+    report("other widgets, per loop", log);
+    if (log.malformed || log.bad) {
+        puts("FAIL: host copy differs from the panel");
+        return false;
+    }
+    return true;
+}
+
+static bool scrollEdgeCases() {
+    TFT_eSPI tft;
+    Capture cap;
+    HostScreen host(tft.width(), tft.height());
+    FrameMirror mirror(&tft, cap);
+    FrameLog log;
+    mirror.begin();
+
+    const char *names[] = {"A", "B"};
+    uint16_t colors[] = {TFT_RED, TFT_GREEN};
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Scroll", LEGEND_BOTTOM, 2, names, colors);
+    endFrame(mirror, cap, host, tft, log);
+
+    for (int i = 0; i < FRAMES; i++) {
+        int a = i % 10 == 9 ? 0 : 50;                  // drops to yMin
+        int b = (i * 37) % 100;                        // steep, crossing A
+        if (i % 50 == 7) g.plotPoint(0, 100 - a);      // replaced below
+        if (i % 50 == 30) {
+            g.plotPoint(1, b);                         // out of series order
+            g.plotPoint(0, a);
+        } else {
+            g.plotPoint(0, a);
+            g.plotPoint(1, b);
+        }
+        g.nextX();
+        endFrame(mirror, cap, host, tft, log);
+    }
+
+    report("yMin + steep, per loop", log);
+    if (log.malformed || log.bad) {
+        puts("FAIL: host copy differs from the panel");
+        return false;
+    }
+    return true;
+}
+
+// PieChart and Gauge paint every pixel of their discs for all sketches, not
+// just mirrored ones, so their draw cost is reported without a mirror
+static void discCost() {
+    static const int DRAWS = 200;
+    TFT_eSPI tft;
+    const char *names[] = {"A", "B", "C"};
+    uint16_t colors[] = {TFT_RED, TFT_GREEN, TFT_YELLOW};
+    PieChart pie(&tft, 0, 0, 240, 240, "Pie", LEGEND_BOTTOM, 3, names, colors);
+    Gauge gauge(&tft, 120, 120, 100, TFT_BLACK, TFT_CYAN);
+
+    tft.resetStats();
+    BenchTimer t;
+    for (int i = 0; i < DRAWS; i++) {
+        float v[] = {(float)(i % 40 + 10), 30, 25};
+        pie.setData(v);
+        pie.draw();
+    }
+    printBus("PieChart::draw, r 100", tft.stats, t.ms(), DRAWS);
+
+    tft.resetStats();
+    t = BenchTimer();
+    for (int i = 0; i < DRAWS; i++) gauge.setValue(i % 100);
+    printBus("Gauge::setValue, r 100", tft.stats, t.ms(), DRAWS);
+}
+
+int main() {
+    printf("%d loops, %.0f baud (10 bits per byte)\n", FRAMES, BAUD);
+    printf("%-26s %9s %9s %9s %9s %9s %9s\n", "", "avg B", "max B",
+           "avg s", "max s", "px read", "bad");
+    bool ok = dashboard();
+    ok = otherWidgets() && ok;
+    ok = scrollEdgeCases() && ok;
+    printf("\n");
+    printBusHeader();
+    discCost();
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
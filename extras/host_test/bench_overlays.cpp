@@ -0,0 +1,134 @@
+// Cost of Graph's statistics overlays: three series with no overlay, EMA,
+// windowed mean or a P² percentile band on each, per update (plotPoint for
+// every series + nextX) while the plot fills and once it scrolls.
+//
+// Also checks that a band is drawn under series plotted before it in the
+// same column: series 0 (red, anti-aliased against black) must leave as many
+// red-only pixels with a band on series 1 as without it, and that a windowed
+// mean set on a graph that already has data, or fed the same column twice,
+// follows the samples on screen.
+#include <GraphTFT.h>
+#include "bench.h"
+#include <math.h>
+
+static const int SERIES = 3;
+static const char *names[] = {"A", "B", "C"};
+static uint16_t colors[] = {TFT_RED, TFT_GREEN, TFT_YELLOW};
+
+static int value(int series, int i) {
+    return 50 + (int)(35 * sinf(i * (0.05f + 0.03f * series) + series));
+}
+
+struct Result {
+    BusStats fill, scroll;
+    double fillMs, scrollMs;
+    int fillN, scrollN;
+};
+
+static Result run(SeriesStat mode, float param) {
+    TFT_eSPI tft;
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Overlays", LEGEND_RIGHT, SERIES, names, colors);
+    for (int s = 0; s < SERIES; s++) g.setOverlay(s, mode, param);
+
+    Result r;
+    r.fillN = g.plotWidth() - 1;
+    r.scrollN = 200;
+    for (int phase = 0; phase < 2; phase++) {
+        int n = phase ? r.scrollN : r.fillN;
+        tft.resetStats();
+        BenchTimer t;
+        for (int i = 0; i < n; i++) {
+            int k = phase * r.fillN + i;
+            for (int s = 0; s < SERIES; s++) g.plotPoint(s, value(s, k));
+            g.nextX();
+        }
+        (phase ? r.scrollMs : r.fillMs) = t.ms();
+        (phase ? r.scroll : r.fill) = tft.stats;
+    }
+    return r;
+}
+
+// pixels with red and nothing else after filling the plot once
+static long seriesPixels(bool band) {
+    TFT_eSPI tft;
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Band", LEGEND_RIGHT, 2, names, colors);
+    if (band) g.setOverlay(1, STAT_BAND);
+    for (int i = 0; i < g.plotWidth() - 1; i++) {
+        g.plotPoint(0, value(0, i));
+        g.plotPoint(1, (i * 37) % 100);   // spread, so the band covers series 0
+        g.nextX();
+    }
+    long n = 0;
+    for (uint16_t c : tft.fb) n += (c >> 11) && !(c & 0x07FF);
+    return n;
+}
+
+// the mean is tinted with white, the series (red) is not: the overlay ends
+// where green peaks in a column, give or take the anti-aliasing of a steep line
+static bool meanAt(TFT_eSPI &tft, const Graph &g, int x, int row) {
+    int peak = 0, at = -1;
+    for (int y = 21; y < 20 + g.plotHeight() - 1; y++) {   // inside the box edges
+        int green = (tft.pixel(x, y) >> 5) & 0x3F;
+        if (green > peak) { peak = green; at = y; }
+    }
+    return at >= 0 && abs(at - row) <= 1;
+}
+
+// setOverlay(STAT_MEAN, 5) after 20 columns of data, then a series plotted
+// twice in one column: the mean must be that of the last five values kept
+static bool meanOnData() {
+    TFT_eSPI tft;
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Mean", LEGEND_RIGHT, 1, names, colors);
+    int base = 20 + g.plotHeight();
+    for (int i = 0; i < 20; i++) {
+        g.plotPoint(0, 60);
+        g.nextX();
+    }
+    g.setOverlay(0, STAT_MEAN, 5);
+    int kept[] = {60, 60, 95, 95, 95};
+    for (int i = 20; i < 23; i++) {
+        if (i == 22) g.plotPoint(0, 10);   // replaced by the 95 below
+        g.plotPoint(0, 95);
+        if (i < 22) g.nextX();
+    }
+    long sum = 0;
+    for (int v : kept) sum += map(v, 0, 100, base, 20);
+    int expect = (int)((sum + 2) / 5);
+    bool ok = meanAt(tft, g, 20 + 22, expect);
+    printf("mean set on a graph with data: %s at row %d\n", ok ? "drawn" : "missing", expect);
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    printf("sizeof(Graph) %zu B with or without overlays\n", sizeof(Graph));
+    printBusHeader();
+
+    struct { const char *label; SeriesStat mode; float param; } modes[] = {
+        {"none", STAT_NONE, 0},
+        {"EMA 0.2", STAT_EMA, 0.2f},
+        {"mean 16", STAT_MEAN, 16},
+        {"band p5..p95", STAT_BAND, 0},
+    };
+    for (auto &m : modes) {
+        Result r = run(m.mode, m.param);
+        char label[48];
+        snprintf(label, sizeof(label), "%s, filling", m.label);
+        printBus(label, r.fill, r.fillMs, r.fillN);
+        snprintf(label, sizeof(label), "%s, scrolling", m.label);
+        printBus(label, r.scroll, r.scrollMs, r.scrollN);
+    }
+
+    long plain = seriesPixels(false), banded = seriesPixels(true);
+    printf("series 0 pixels: %ld without band, %ld with\n", plain, banded);
+    if (banded != plain) {
+        puts("FAIL: band drawn over a series plotted before it");
+        ok = false;
+    }
+    if (!meanOnData()) {
+        puts("FAIL: windowed mean lost track of the samples in its window");
+        ok = false;
+    }
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
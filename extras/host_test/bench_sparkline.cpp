@@ -0,0 +1,62 @@
+// Sparkline footprint and the cost of refreshing a 6x5 grid of them with
+// one updateAll() call, next to a Graph.
+//
+// Fails unless each cell costs exactly one transaction per refresh and a
+// Sparkline stays under 128 bytes.
+#include <GraphTFT.h>
+#include "bench.h"
+
+static const int COLS = 6, ROWS = 5, CELLS = COLS * ROWS;
+static const int REFRESHES = 500;
+
+int main() {
+    bool ok = true;
+    printf("sizeof(Sparkline) %zu B (%d samples), sizeof(Graph) %zu B\n",
+           sizeof(Sparkline), Sparkline::maxPoints, sizeof(Graph));
+    printf("%d cells: %zu B of sparklines\n", CELLS, CELLS * sizeof(Sparkline));
+
+    TFT_eSPI tft;
+    static Sparkline *grid[CELLS];
+    int cw = tft.width() / COLS, ch = tft.height() / ROWS;
+    for (int i = 0; i < CELLS; i++) {
+        grid[i] = new Sparkline(&tft, (i % COLS) * cw, (i / COLS) * ch, cw, ch,
+                                0, 100, "T");
+        grid[i]->showMinMax(true);
+        grid[i]->draw();
+    }
+
+    // fill the history first, so every refresh draws a full trend
+    float values[CELLS];
+    for (int k = 0; k < Sparkline::maxPoints; k++) {
+        for (int i = 0; i < CELLS; i++) values[i] = (float)((k * 13 + i * 29) % 100);
+        Sparkline::updateAll(grid, values, CELLS);
+    }
+
+    tft.resetStats();
+    BenchTimer t;
+    for (int k = 0; k < REFRESHES; k++) {
+        for (int i = 0; i < CELLS; i++) values[i] = (float)((k * 13 + i * 29) % 100);
+        Sparkline::updateAll(grid, values, CELLS);
+    }
+    double cpuMs = t.ms();
+    BusStats bus = tft.stats;
+
+    printBusHeader();
+    printBus("grid refresh", bus, cpuMs, REFRESHES);
+    printf("%-28s %10.2f ms (bus + cpu)\n", "per refresh",
+           (busMs(bus) + cpuMs) / REFRESHES);
+
+    if (bus.transactions != (long)CELLS * REFRESHES) {
+        printf("FAIL: %.2f transactions per cell, expected 1\n",
+               (double)bus.transactions / ((long)CELLS * REFRESHES));
+        ok = false;
+    }
+    if (sizeof(Sparkline) >= 128) {
+        puts("FAIL: Sparkline no longer fits in 128 bytes");
+        ok = false;
+    }
+
+    for (int i = 0; i < CELLS; i++) delete grid[i];
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
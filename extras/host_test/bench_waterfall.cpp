@@ -0,0 +1,71 @@
+// Waterfall row rate for 16..4096 bins on a 300-pixel-wide plot: CPU time
+// per row, what each row costs on the bus, and the rows per second the bus
+// allows at BENCH_SPI_MHZ.
+//
+// Fails unless every row is one transaction with a fixed bus cost, and the
+// CPU time grows linearly with the bin count (4x the bins may cost at most
+// 6x the time; quadratic work would cost 16x).
+#include <GraphTFT.h>
+#include "bench.h"
+#include <vector>
+
+static const int ROWS = 2000;
+static const int PLOT_W = 300;
+
+struct Result {
+    BusStats bus;
+    double cpuMs;
+};
+
+static Result run(int bins) {
+    TFT_eSPI tft;
+    Waterfall wf(&tft, 10, 0, PLOT_W, 200, 0, 100, bins, "FFT");
+    // a few prepared rows, so only pushRow() is timed
+    std::vector<float> rows(16 * bins);
+    for (int r = 0; r < 16; r++)
+        for (int i = 0; i < bins; i++) rows[r * bins + i] = (float)((i * 7 + r * 3) % 100);
+
+    tft.resetStats();
+    BenchTimer t;
+    for (int r = 0; r < ROWS; r++) wf.pushRow(&rows[(r % 16) * bins]);
+    Result res;
+    res.cpuMs = t.ms();
+    res.bus = tft.stats;
+    return res;
+}
+
+int main() {
+    bool ok = true;
+    printf("%d rows, %d px wide (bus at %d MHz)\n", ROWS, PLOT_W, BENCH_SPI_MHZ);
+    printf("%-10s %10s %10s %10s %10s %12s %12s\n", "bins", "trans", "windows",
+           "bus B", "cpu us", "rows/s cpu", "rows/s bus");
+
+    const int binCounts[] = {16, 64, 256, 1024, 4096};
+    double prevUs = 0;
+    long busBytes = -1;
+    for (int bins : binCounts) {
+        Result r = run(bins);
+        double cpuUs = r.cpuMs * 1000.0 / ROWS;
+        double busUs = busMs(r.bus) * 1000.0 / ROWS;
+        printf("%-10d %10.2f %10.2f %10ld %10.3f %12.0f %12.0f\n", bins,
+               (double)r.bus.transactions / ROWS, (double)r.bus.windows / ROWS,
+               r.bus.busBytes / ROWS, cpuUs, 1e6 / cpuUs, 1e6 / busUs);
+
+        if (r.bus.transactions != ROWS) {
+            puts("FAIL: a row takes more than one transaction");
+            ok = false;
+        }
+        if (busBytes >= 0 && r.bus.busBytes != busBytes) {
+            puts("FAIL: bus cost of a row depends on the bin count");
+            ok = false;
+        }
+        busBytes = r.bus.busBytes;
+        if (prevUs > 0 && cpuUs > prevUs * 6) {
+            puts("FAIL: row time grows faster than the bin count");
+            ok = false;
+        }
+        prevUs = cpuUs;
+    }
+    puts(ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// examples/DashboardExample on the host: same widgets, layout and update
+// loop, minus the delay(). Shared by the tests and benchmarks that need a
+// realistic frame.
+#ifndef HOST_DASHBOARD_H
+#define HOST_DASHBOARD_H
+
+#include <GraphTFT.h>
+
+struct Dashboard {
+    TFT_eSPI &tft;
+    uint16_t colors[4];
+    uint16_t panel;
+    const char *lineNames[2];
+    const char *barNames[3];
+    const char *pieNames[3];
+    Gauge moistureGauge;
+    Graph lineChart;
+    BarChart barChart;
+    PieChart pieChart;
+    int counter;
+
+    explicit Dashboard(TFT_eSPI &display)
+        : tft(display),
+          colors{tft.color565(66, 135, 245), tft.color565(102, 187, 106),
+                 tft.color565(255, 167, 38), tft.color565(171, 71, 188)},
+          panel(tft.color565(30, 30, 30)),
+          lineNames{"Temp C", "Hum %"},
+          barNames{"ON", "OFF", "ALERT"},
+          pieNames{"Solar", "Grid", "Battery"},
+          moistureGauge(&tft, 120, 60, 50, panel, colors[1]),
+          lineChart(&tft, 0, 0, 245, 100, 0, 100, "Climate Monitor",
+                    LEGEND_BOTTOM, 2, lineNames, colors, panel),
+          barChart(&tft, 0, 100, 160, 140, "Device Status",
+                   LEGEND_BOTTOM, 3, barNames, colors, panel),
+          pieChart(&tft, 160, 100, 160, 140, "Energy Mix",
+                   LEGEND_BOTTOM, 3, pieNames, colors, panel),
+          counter(0) {}
+
+    void drawMiniWidget(float temp, float hum) {
+        int x0 = 250, y0 = 20, w = 65, h = 65;
+        tft.fillRect(x0, y0, w, h, tft.color565(50, 50, 50));
+        tft.drawRect(x0, y0, w, h, TFT_WHITE);
+        char num[8], line[16];
+        snprintf(line, sizeof(line), "T: %sC", dtostrf(temp, 1, 1, num));
+        tft.drawString(line, x0 + 5, y0 + 16);
+        snprintf(line, sizeof(line), "H: %s%%", dtostrf(hum, 1, 1, num));
+        tft.drawString(line, x0 + 5, y0 + 40);
+    }
+
+    void setup() {
+        tft.fillScreen(tft.color565(20, 20, 20));
+        lineChart.resetGraph();
+        float barVals[] = {10, 5, 2};
+        barChart.setData(barVals);
+        barChart.draw();
+        float pieVals[] = {50, 30, 20};
+        pieChart.setData(pieVals);
+        pieChart.draw();
+        moistureGauge.setValue(0);
+    }
+
+    void loop() {
+        float temp = 20 + random(-2, 3) + sin(counter * 0.2) * 5;
+        float hum  = 50 + random(-3, 4) + cos(counter * 0.15) * 10;
+
+        lineChart.plotPoint(0, temp);
+        lineChart.plotPoint(1, hum);
+        lineChart.nextX();
+
+        drawMiniWidget(temp, hum);
+
+        float barVals[] = {(float)random(5, 15), (float)random(2, 10), (float)random(1, 6)};
+        barChart.setData(barVals);
+        barChart.draw();
+
+        float solar = random(30, 60);
+        float grid  = random(10, 40);
+        float batt  = 100 - solar - grid;
+        float pieVals[] = {solar, grid, batt};
+        pieChart.setData(pieVals);
+        pieChart.draw();
+
+        moistureGauge.setValue((int)random(0, 100));
+        counter++;
+    }
+};
+
+#endif
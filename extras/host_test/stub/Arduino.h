@@ -0,0 +1,60 @@
+// Minimal Arduino core stand-in so GraphTFT builds and runs on a PC.
+// Only what the library itself uses; deliberately no String class.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <type_traits>
+
+#define PROGMEM
+
+// by value: mixed argument types promote like the Arduino macros do
+template<class A, class B>
+inline typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template<class A, class B>
+inline typename std::common_type<A, B>::type max(A a, B b) { return a > b ? a : b; }
+template<class T, class L, class H>
+inline T constrain(T v, L lo, H hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+inline float radians(float deg) { return deg * 0.017453292519943295f; }
+
+// deterministic, so benchmark runs are repeatable
+inline long random(long lo, long hi) {
+    static uint32_t state = 12345;
+    state = state * 1103515245u + 12345u;
+    return hi > lo ? lo + (long)((state >> 8) % (uint32_t)(hi - lo)) : lo;
+}
+
+// fake clock advanced by delay()
+inline uint32_t &hostClock() { static uint32_t ms = 0; return ms; }
+inline unsigned long millis() { return hostClock(); }
+inline void delay(unsigned long ms) { hostClock() += ms; }
+
+inline char *dtostrf(double val, signed char width, unsigned char prec, char *buf) {
+    sprintf(buf, "%*.*f", width, prec, val);
+    return buf;
+}
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t n) {
+        for (size_t i = 0; i < n; i++) write(buf[i]);
+        return n;
+    }
+    size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+};
+
+class Stream : public Print {};
+
+#endif
@@ -0,0 +1,212 @@
+// Framebuffer-backed TFT_eSPI stand-in for host tests and benchmarks.
+// Draws into a RGB565 array and counts what a real SPI panel would see:
+// transactions (CS low periods), address windows, pixels and bus bytes.
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define TFT_BLACK    0x0000
+#define TFT_BLUE     0x001F
+#define TFT_RED      0xF800
+#define TFT_GREEN    0x07E0
+#define TFT_CYAN     0x07FF
+#define TFT_MAGENTA  0xF81F
+#define TFT_YELLOW   0xFFE0
+#define TFT_ORANGE   0xFDA0
+#define TFT_PINK     0xFE19
+#define TFT_DARKGREY 0x7BEF
+#define TFT_WHITE    0xFFFF
+
+struct BusStats {
+    long transactions = 0;   // CS low periods
+    long primitives = 0;     // calls that would each be a transaction unbatched
+    long pixelCalls = 0;     // drawPixel() calls
+    long windows = 0;        // address window setups
+    long pixelsWritten = 0;
+    long pixelsRead = 0;
+    long busBytes = 0;       // command + pixel bytes on the wire
+};
+
+class TFT_eSPI : public Print {
+public:
+    BusStats stats;
+    std::vector<uint16_t> fb;
+
+    TFT_eSPI(int w = 320, int h = 240) : W(w), H(h) { fb.assign(w * h, 0); }
+
+    void init() {}
+    void setRotation(uint8_t) {}
+    void invertDisplay(bool) {}
+    int16_t width() const { return W; }
+    int16_t height() const { return H; }
+    void resetStats() { stats = BusStats(); }
+    uint16_t pixel(int x, int y) const { return fb[y * W + x]; }
+
+    // ---- transactions
+    void startWrite() { if (!locked) stats.transactions++; locked = true; }
+    void endWrite() { locked = false; }
+
+    // ---- pixels and rectangles
+    void drawPixel(int32_t x, int32_t y, uint32_t c) {
+        prim(); stats.pixelCalls++; window(); put(x, y, c);
+    }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) {
+        prim(); window();
+        // clip first, like TFT_eSPI, so off-screen sizes cost nothing
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (w > W - x) w = W - x;
+        if (h > H - y) h = H - y;
+        for (int j = y; j < y + h; j++) for (int i = x; i < x + w; i++) put(i, j, c);
+    }
+    void fillScreen(uint32_t c) { fillRect(0, 0, W, H, c); }
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t c) { fillRect(x, y, w, 1, c); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t c) { fillRect(x, y, 1, h, c); }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) {
+        drawFastHLine(x, y, w, c); drawFastHLine(x, y + h - 1, w, c);
+        drawFastVLine(x, y, h, c); drawFastVLine(x + w - 1, y, h, c);
+    }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t, uint32_t c) { fillRect(x, y, w, h, c); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t, uint32_t c) { drawRect(x, y, w, h, c); }
+
+    void drawCircle(int32_t cx, int32_t cy, int32_t r, uint32_t c) {
+        prim(); window();
+        for (int a = 0; a < 8 * r + 8; a++) {
+            float t = a * 6.2831853f / (8 * r + 8);
+            put(cx + (int)lroundf(r * cosf(t)), cy + (int)lroundf(r * sinf(t)), c);
+        }
+    }
+    void fillCircle(int32_t cx, int32_t cy, int32_t r, uint32_t c) {
+        prim();
+        for (int dy = -r; dy <= r; dy++) {
+            int dx = (int)sqrtf((float)(r * r - dy * dy));
+            window();
+            for (int i = cx - dx; i <= cx + dx; i++) put(i, cy + dy, c);
+        }
+    }
+    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                      int32_t x2, int32_t y2, uint32_t c) {
+        prim(); window();
+        int minX = min(x0, min(x1, x2)), maxX = max(x0, max(x1, x2));
+        int minY = min(y0, min(y1, y2)), maxY = max(y0, max(y1, y2));
+        for (int y = minY; y <= maxY; y++)
+            for (int x = minX; x <= maxX; x++) {
+                long e0 = (long)(x1 - x0) * (y - y0) - (long)(y1 - y0) * (x - x0);
+                long e1 = (long)(x2 - x1) * (y - y1) - (long)(y2 - y1) * (x - x1);
+                long e2 = (long)(x0 - x2) * (y - y2) - (long)(y0 - y2) * (x - x2);
+                if ((e0 >= 0 && e1 >= 0 && e2 >= 0) || (e0 <= 0 && e1 <= 0 && e2 <= 0)) put(x, y, c);
+            }
+    }
+
+    // ---- raw window writes
+    void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+        prim(); window();
+        wx = x; wy = y; ww = w; wh = h; wpos = 0;
+    }
+    void pushColor(uint16_t c) { pushColor(c, 1); }
+    void pushColor(uint16_t c, uint32_t len) {
+        prim();
+        for (uint32_t i = 0; i < len; i++) windowPut(c);
+    }
+    void pushColors(uint16_t *data, uint32_t len, bool swap = true) {
+        prim();
+        for (uint32_t i = 0; i < len; i++) windowPut(swap ? data[i] : swap565(data[i]));
+    }
+
+    // ---- reads (colours come back byte-swapped, as on the real library)
+    void readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data) {
+        prim(); window();
+        for (int j = 0; j < h; j++)
+            for (int i = 0; i < w; i++) {
+                int px = x + i, py = y + j;
+                uint16_t c = (px >= 0 && py >= 0 && px < W && py < H) ? fb[py * W + px] : 0;
+                data[j * w + i] = swap565(c);
+                stats.pixelsRead++;
+                stats.busBytes += 3;   // 18-bit reads
+            }
+    }
+    void pushRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data) {
+        prim(); window();
+        for (int j = 0; j < h; j++)
+            for (int i = 0; i < w; i++) put(x + i, y + j, swap565(data[j * w + i]));
+    }
+
+    // ---- text: fixed-pitch cells filled with a per-character dot pattern,
+    // so text costs roughly what real glyphs would when read back
+    void setTextColor(uint16_t fg) { textFg = fg; textFill = false; }
+    void setTextColor(uint16_t fg, uint16_t bg, bool = false) {
+        textFg = fg; textBg = bg; textFill = true;
+    }
+    void setTextSize(uint8_t) {}
+    void setTextFont(uint8_t font) { textFont = font; }
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+    int16_t fontHeight(int16_t font = 1) { return font == 4 ? 26 : font == 2 ? 16 : 8; }
+    int16_t textWidth(const char *s, uint8_t font = 1) {
+        return cellWidth(font) * (int16_t)strlen(s);
+    }
+    int16_t drawString(const char *s, int32_t x, int32_t y) { return drawString(s, x, y, textFont); }
+    int16_t drawString(const char *s, int32_t x, int32_t y, uint8_t font) {
+        prim();
+        for (int i = 0; s[i]; i++) glyph(s[i], x + i * cellWidth(font), y, font);
+        return textWidth(s, font);
+    }
+    int16_t drawCentreString(const char *s, int32_t x, int32_t y, uint8_t font) {
+        return drawString(s, x - textWidth(s, font) / 2, y, font);
+    }
+    size_t write(uint8_t ch) override {
+        prim();
+        glyph(ch, cursorX, cursorY, textFont);
+        cursorX += cellWidth(textFont);
+        return 1;
+    }
+
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+
+private:
+    int W, H;
+    bool locked = false;
+    uint16_t textFg = 0xFFFF, textBg = 0;
+    bool textFill = false;
+    uint8_t textFont = 1;
+    int cursorX = 0, cursorY = 0;
+
+    static int cellWidth(int font) { return font == 4 ? 14 : font == 2 ? 8 : 6; }
+    void glyph(uint8_t ch, int x, int y, int font) {
+        window();
+        int cw = cellWidth(font), chh = fontHeight(font);
+        for (int j = 0; j < chh; j++)
+            for (int i = 0; i < cw - 1; i++) {
+                bool on = ch != ' ' && ((ch * 31 + i * 7 + j * 13) % 5) < 2;
+                if (on) put(x + i, y + j, textFg);
+                else if (textFill) put(x + i, y + j, textBg);
+            }
+        if (textFill) for (int j = 0; j < chh; j++) put(x + cw - 1, y + j, textBg);
+    }
+    int wx = 0, wy = 0, ww = 0, wh = 0;
+    long wpos = 0;
+
+    static uint16_t swap565(uint16_t c) { return (c >> 8) | (c << 8); }
+
+    void prim() {
+        stats.primitives++;
+        if (!locked) stats.transactions++;
+    }
+    // CASET + RASET + RAMWR with their parameters
+    void window() { stats.windows++; stats.busBytes += 11; }
+    void put(int x, int y, uint32_t c) {
+        stats.pixelsWritten++;
+        stats.busBytes += 2;
+        if (x >= 0 && y >= 0 && x < W && y < H) fb[y * W + x] = (uint16_t)c;
+    }
+    void windowPut(uint16_t c) {
+        if (ww <= 0 || wh <= 0) return;
+        put(wx + (int)(wpos % ww), wy + (int)(wpos / ww), c);
+        wpos = (wpos + 1) % ((long)ww * wh);
+    }
+};
+
+#endif
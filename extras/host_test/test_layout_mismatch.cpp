@@ -0,0 +1,13 @@
+// Built only by the test_layout_mismatch ctest, which expects it NOT to
+// link: the library is built with the default GRAPH_MAX_SERIES, and a
+// sketch that #defines another value before the include would otherwise
+// get a Graph of a different size than GraphTFT.cpp writes to.
+#define GRAPH_MAX_SERIES 8
+#include <GraphTFT.h>
+
+int main() {
+    TFT_eSPI tft;
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "Mismatch");
+    g.plotPoint(0, 50);
+    return 0;
+}
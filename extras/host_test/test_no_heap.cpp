@@ -0,0 +1,112 @@
+// Every widget must run without touching the heap once constructed.
+// malloc & co. are interposed and counted while the update loop runs.
+#include <GraphTFT.h>
+#include <stdio.h>
+
+#if !defined(__GLIBC__)
+int main() { puts("SKIP: malloc interposition needs glibc"); return 0; }
+#else
+
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *__libc_calloc(size_t, size_t);
+extern "C" void *__libc_realloc(void *, size_t);
+extern "C" void __libc_free(void *);
+
+static bool counting = false;
+static long allocations = 0;
+
+extern "C" void *malloc(size_t n) { if (counting) allocations++; return __libc_malloc(n); }
+extern "C" void *calloc(size_t n, size_t s) { if (counting) allocations++; return __libc_calloc(n, s); }
+extern "C" void *realloc(void *p, size_t n) { if (counting) allocations++; return __libc_realloc(p, n); }
+extern "C" void free(void *p) { __libc_free(p); }
+
+static const int CYCLES = 2000;
+
+int main() {
+    TFT_eSPI tft;
+    const char *names[] = {"Temp", "Hum", "Press"};
+    uint16_t colors[] = {TFT_RED, TFT_GREEN, TFT_BLUE};
+
+    Graph line(&tft, 0, 0, 200, 100, 0, 100, "Line", LEGEND_BOTTOM, 3, names, colors);
+    line.setOverlay(0, STAT_EMA, 0.2f);
+    line.setOverlay(1, STAT_MEAN, 10);
+    line.setOverlay(2, STAT_BAND);
+
+    Graph frame(&tft, 0, 100, 160, 80, 0, 100, "Frame", LEGEND_RIGHT, 2, names, colors);
+    IndexedCanvas canvas(frame.plotWidth(), frame.plotHeight(), 4);
+    Graph canvasGraph(&tft, 160, 100, 160, 80, 0, 100, "Canvas", LEGEND_RIGHT, 1, names, colors);
+    canvasGraph.setCanvas(&canvas);
+
+    static TimedSample history[256];
+    Graph timed(&tft, 200, 0, 120, 100, 0, 100, "Timed", LEGEND_TOP, 2, names, colors);
+    timed.setTimeWindow(history, 256, 60000, 5000);
+
+    BarChart bars(&tft, 0, 180, 100, 60, "Bars", LEGEND_BOTTOM, 3, names, colors);
+    PieChart pie(&tft, 100, 180, 100, 60, "Pie", LEGEND_RIGHT, 3, names, colors);
+    Gauge gauge(&tft, 250, 200, 30);
+    Card card(&tft, 200, 180, 40, 60, "Card");
+    Sparkline s0(&tft, 0, 0, 60, 40), s1(&tft, 60, 0, 60, 40, 0, 100, "T");
+    s1.showMinMax(true);
+    Sparkline *grid[] = {&s0, &s1};
+    Waterfall wf(&tft, 0, 0, 320, 60, 0, 100, 32, "FFT");
+
+    struct NullStream : Stream { size_t write(uint8_t) override { return 1; } } sink;
+    FrameMirror mirror(&tft, sink);
+    mirror.begin();
+
+    // make sure the hook is live before trusting a zero count
+    counting = true;
+    free(malloc(16));
+    counting = false;
+    if (allocations != 1) {
+        puts("FAIL: malloc hook not active");
+        return 1;
+    }
+    allocations = 0;
+
+    counting = true;
+    for (int i = 0; i < CYCLES; i++) {
+        int v = (i * 37) % 100;
+        line.plotPoint(0, v);
+        line.plotPoint(1, 100 - v);
+        line.plotPoint(2, (v * 3) % 100);
+        line.nextX();
+
+        int fv[] = {v, 50};
+        frame.plotFrame(fv);
+        frame.nextX();
+        canvasGraph.plotPoint(0, v);
+        canvasGraph.nextX();
+
+        if (i % 7) timed.plotPoint(i % 2, v, millis());
+        timed.updateTime(millis());
+        delay(500);
+
+        float bv[] = {(float)v, 10.5f, i % 2 ? 1e30f : -3.4e38f};
+        bars.setData(bv);
+        bars.draw();
+        pie.setData(bv);
+        pie.draw();
+        gauge.setValue(v);
+        card.draw();
+
+        float sv[] = {(float)v, (float)(100 - v)};
+        Sparkline::updateAll(grid, sv, 2);
+
+        float row[32];
+        for (int k = 0; k < 32; k++) row[k] = (float)((k * v) % 100);
+        wf.pushRow(row);
+
+        mirror.sendFrame();
+    }
+    counting = false;
+
+    printf("%d update cycles, %ld heap allocations\n", CYCLES, allocations);
+    if (allocations != 0) {
+        puts("FAIL: widgets allocated after construction");
+        return 1;
+    }
+    puts("PASS");
+    return 0;
+}
+#endif
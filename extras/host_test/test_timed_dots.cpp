@@ -0,0 +1,51 @@
+// Time-indexed Graph: a reading joined to neither neighbour is drawn as a
+// solid 3x3 dot, on the panel and through a canvas; readings that are part
+// of a line get no dot.
+#include <GraphTFT.h>
+#include <stdio.h>
+
+// centres of solid 3x3 blocks of `colour`
+static int countDots(const TFT_eSPI &tft, uint16_t colour) {
+    int n = 0;
+    for (int y = 1; y < tft.height() - 1; y++)
+        for (int x = 1; x < tft.width() - 1; x++) {
+            bool solid = true;
+            for (int j = -1; j <= 1 && solid; j++)
+                for (int i = -1; i <= 1 && solid; i++)
+                    solid = tft.pixel(x + i, y + j) == colour;
+            n += solid;
+        }
+    return n;
+}
+
+// dots drawn by the readings, over the legend's own solid box
+static int run(bool withCanvas, bool readings = true) {
+    TFT_eSPI tft;
+    uint16_t colors[] = {TFT_RED};
+    Graph g(&tft, 0, 0, 320, 240, 0, 100, "DHT22", LEGEND_BOTTOM, 1, nullptr, colors);
+    IndexedCanvas canvas(g.plotWidth(), g.plotHeight(), 4);
+    if (withCanvas) g.setCanvas(&canvas);
+
+    static TimedSample ring[32];
+    g.setTimeWindow(ring, 32, 10000, 1500);
+    if (!readings) {
+        g.updateTime(10000);
+        return countDots(tft, TFT_RED);
+    }
+    g.plotPoint(0, 50, 1000);      // alone: the next reading is 4 s later
+    g.plotPoint(0, 30, 5000);      // a line of three
+    g.plotPoint(0, 70, 6000);
+    g.plotPoint(0, 40, 7000);
+    g.plotPoint(0, 20, 9000);      // alone again, and the newest
+    g.updateTime(10000);
+    return countDots(tft, TFT_RED) - run(withCanvas, false);
+}
+
+int main() {
+    int panel = run(false), canvas = run(true);
+    printf("isolated readings drawn as dots: %d on the panel, %d via canvas\n",
+           panel, canvas);
+    bool ok = panel == 2 && canvas == 2;
+    puts(ok ? "PASS" : "FAIL: expected exactly the two isolated readings");
+    return ok ? 0 : 1;
+}
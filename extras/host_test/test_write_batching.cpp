@@ -0,0 +1,73 @@
+// Write batching and AA run merging must change how pixels reach the panel,
+// never which pixels. The same dashboard run is rendered by this library
+// build and by one with AA_RUN_PIXELS=1 (every AA pixel its own drawPixel);
+// framebuffers must match and the batched build must need far fewer
+// transactions than the unbatched one would (one per primitive).
+//
+//   test_write_batching                 run the dashboard, print a summary
+//   test_write_batching <baseline exe>  also run the baseline and compare
+#include "dashboard.h"
+#include "bench.h"
+
+static const int FRAMES = 300;
+
+struct Summary {
+    unsigned long hash;
+    long primitives, transactions, pixelCalls;
+};
+
+static Summary render() {
+    TFT_eSPI tft;
+    Dashboard dash(tft);
+    dash.setup();
+    for (int i = 0; i < FRAMES; i++) dash.loop();
+
+    Summary s;
+    s.hash = 2166136261u;   // FNV-1a over the framebuffer
+    for (size_t i = 0; i < tft.fb.size(); i++) {
+        s.hash = (s.hash ^ (tft.fb[i] & 0xFF)) * 16777619u & 0xFFFFFFFFu;
+        s.hash = (s.hash ^ (tft.fb[i] >> 8)) * 16777619u & 0xFFFFFFFFu;
+    }
+    s.primitives = tft.stats.primitives;
+    s.transactions = tft.stats.transactions;
+    s.pixelCalls = tft.stats.pixelCalls;
+    return s;
+}
+
+int main(int argc, char **argv) {
+    Summary after = render();
+    if (argc < 2) {
+        printf("%08lx %ld %ld %ld\n", after.hash, after.primitives,
+               after.transactions, after.pixelCalls);
+        return 0;
+    }
+
+    FILE *p = popen(argv[1], "r");
+    Summary before;
+    bool ok = p && fscanf(p, "%lx %ld %ld %ld", &before.hash, &before.primitives,
+                          &before.transactions, &before.pixelCalls) == 4;
+    if (p) pclose(p);
+    if (!ok) {
+        printf("FAIL: could not run %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("dashboard, %d frames\n", FRAMES);
+    printf("%-34s %12s %12s\n", "", "drawPixel", "transactions");
+    printf("%-34s %12ld %12ld\n", "unmerged, unbatched (before)",
+           before.pixelCalls, before.primitives);
+    printf("%-34s %12ld %12ld\n", "runs + WriteBatch (after)",
+           after.pixelCalls, after.transactions);
+    printf("framebuffer %08lx vs %08lx\n", before.hash, after.hash);
+
+    if (before.hash != after.hash) {
+        puts("FAIL: batching changed the output");
+        return 1;
+    }
+    if (after.transactions * 2 > before.primitives) {
+        puts("FAIL: less than half the transactions saved");
+        return 1;
+    }
+    puts("PASS");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Decode a GraphTFT FrameMirror stream into PPM snapshots.
+
+Reads the byte stream produced by FrameMirror::sendFrame() from a file or a
+serial port, applies each frame's ops (window, pixel runs, fills, scrolls;
+see FrameMirror in src/GraphTFT.h) to a local copy of the screen and writes
+the result to a PPM image after every frame. Bytes outside frames (debug prints
+sharing the port) are skipped by scanning for the 'GF' header.
+
+    python3 mirror_decode.py capture.bin --size 320x240 --out screen.ppm
+    python3 mirror_decode.py /dev/ttyUSB0 --baud 115200 --size 320x240
+"""
+import argparse
+import sys
+
+
+def open_source(path, baud):
+    if baud:
+        import serial  # pyserial, only needed for live capture
+        return serial.Serial(path, baud)
+    return open(path, "rb")
+
+
+def read_exact(src, n):
+    data = b""
+    while len(data) < n:
+        chunk = src.read(n - len(data))
+        if not chunk:
+            raise EOFError
+        data += chunk
+    return data
+
+
+def u16(b, i):
+    return b[i] | (b[i + 1] << 8)
+
+
+class Screen:
+    """Local copy of the panel plus the write window that carries over
+    between frames."""
+
+    def __init__(self, width, height):
+        self.width, self.height = width, height
+        self.fb = [0] * (width * height)
+        self.win = (0, 0, 0, 0)
+        self.cursor = 0
+
+    def put(self, x, y, colour):
+        if 0 <= x < self.width and 0 <= y < self.height:
+            self.fb[y * self.width + x] = colour
+
+    def window(self, x, y, w, h):
+        self.win = (x, y, w, h)
+        self.cursor = 0
+
+    def pixels(self, src):
+        runs = u16(read_exact(src, 2), 0)
+        x, y, w, h = self.win
+        for _ in range(runs):
+            run = read_exact(src, 3)
+            length, colour = run[0], u16(run, 1)
+            if w == 0 or h == 0:
+                continue
+            for _ in range(length):
+                self.put(x + self.cursor % w, y + self.cursor // w, colour)
+                self.cursor = (self.cursor + 1) % (w * h)
+
+    def fill(self, x, y, w, h, colour):
+        for py in range(y, y + h):
+            for px in range(x, x + w):
+                self.put(px, py, colour)
+
+    def scroll(self, x, y, w, h, dx):
+        # columns uncovered by the move keep their old content
+        for py in range(y, min(y + h, self.height)):
+            row = py * self.width
+            cols = range(x, x + w + dx) if dx < 0 else range(x + w - 1, x + dx - 1, -1)
+            for px in cols:
+                self.fb[row + px] = self.fb[row + px - dx]
+
+    def apply(self, src, ops):
+        for _ in range(ops):
+            op = read_exact(src, 1)
+            if op == b"W":
+                hdr = read_exact(src, 8)
+                self.window(*(u16(hdr, i) for i in range(0, 8, 2)))
+            elif op == b"D":
+                self.pixels(src)
+            elif op in (b"F", b"S"):
+                hdr = read_exact(src, 10)
+                x, y, w, h, v = (u16(hdr, i) for i in range(0, 10, 2))
+                if op == b"F":
+                    self.fill(x, y, w, h, v)
+                else:
+                    self.scroll(x, y, w, h, v - 0x10000 if v & 0x8000 else v)
+            else:
+                return False  # lost sync: look for the next header
+        return True
+
+
+def write_ppm(path, screen):
+    out = bytearray()
+    for c in screen.fb:
+        r, g, b = (c >> 11) & 0x1F, (c >> 5) & 0x3F, c & 0x1F
+        out += bytes(((r * 255) // 31, (g * 255) // 63, (b * 255) // 31))
+    with open(path, "wb") as f:
+        f.write(b"P6 %d %d 255\n" % (screen.width, screen.height))
+        f.write(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="capture file or serial port")
+    ap.add_argument("--baud", type=int, help="open source as a serial port")
+    ap.add_argument("--size", default="320x240", help="screen size WxH")
+    ap.add_argument("--out", default="screen.ppm", help="snapshot path")
+    args = ap.parse_args()
+
+    width, height = (int(v) for v in args.size.split("x"))
+    screen = Screen(width, height)
+    src = open_source(args.source, args.baud)
+    frames = 0
+    try:
+        prev = b""
+        while True:
+            byte = read_exact(src, 1)
+            if prev + byte != b"GF":
+                prev = byte
+                continue
+            prev = b""
+            ops = u16(read_exact(src, 2), 0)
+            if screen.apply(src, ops):
+                frames += 1
+                write_ppm(args.out, screen)
+    except (EOFError, KeyboardInterrupt):
+        pass
+    print("%d frames decoded" % frames, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
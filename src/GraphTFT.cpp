@@ -6,12 +6,108 @@
 //  helper routines for simple anti-aliased drawing
 // -----------------------------------------------------------------------------
 
-// you can disable pixel reads if your controller doesn't support them or if
-// performance is a concern. define to 0 before including GraphTFT.h.
+// when enabled, anti-aliased lines read the panel area they cover back in a
+// single readRect, blend against the real destination pixels (other series,
+// gridlines, ...) and push the block back in one go. needs a controller with
+// a working read path (MISO wired), so it is off by default; enable it with
+// a build flag, e.g. -DAA_USE_READPIXEL=1.
 #ifndef AA_USE_READPIXEL
-#define AA_USE_READPIXEL 1
+#define AA_USE_READPIXEL 0
 #endif
 
+// largest block (in pixels) read back for one line; longer lines fall back to
+// blending against the fixed background colour. costs 2 bytes per pixel of RAM.
+#ifndef AA_READ_BLOCK_PIXELS
+#define AA_READ_BLOCK_PIXELS 512
+#endif
+
+// longest run of adjacent AA pixels merged into one address window + push
+#ifndef AA_RUN_PIXELS
+#define AA_RUN_PIXELS 32
+#endif
+
+// -----------------------------------------------------------------------------
+//  write combining
+// -----------------------------------------------------------------------------
+
+// keeps the panel selected for the whole of a widget operation instead of
+// one transaction per primitive. nests: only the outermost batch issues
+// startWrite()/endWrite(), so widget methods can call each other freely.
+static int writeDepth = 0;
+
+class WriteBatch {
+public:
+    explicit WriteBatch(TFT_eSPI *display) : tft(display) {
+        if (writeDepth++ == 0) tft->startWrite();
+    }
+    ~WriteBatch() {
+        if (--writeDepth == 0) tft->endWrite();
+    }
+
+private:
+    TFT_eSPI *tft;
+};
+
+// panel reads can't share a write transaction; step out of the batch for the
+// duration of the read
+static void readBlock(TFT_eSPI *tft, int x, int y, int w, int h, uint16_t *buf) {
+    if (writeDepth > 0) tft->endWrite();
+    tft->readRect(x, y, w, h, buf);
+    if (writeDepth > 0) tft->startWrite();
+}
+
+// consecutive pixels on one row or column, sent as a single window + push
+struct PixelRun {
+    int x, y, len;
+    bool vertical;
+    uint16_t px[AA_RUN_PIXELS];
+};
+
+static void flushRun(TFT_eSPI *tft, PixelRun &r) {
+    if (r.len == 0) return;
+    if (r.len == 1) {
+        tft->drawPixel(r.x, r.y, r.px[0]);
+    } else {
+        if (r.vertical) tft->setAddrWindow(r.x, r.y, 1, r.len);
+        else            tft->setAddrWindow(r.x, r.y, r.len, 1);
+        tft->pushColors(r.px, r.len);
+    }
+    FrameMirror::teeWindow(tft, r.x, r.y, r.vertical ? 1 : r.len, r.vertical ? r.len : 1);
+    FrameMirror::teePixels(tft, r.px, r.len);
+    r.len = 0;
+}
+
+// fillRect, copied to an active FrameMirror
+static void fillMirrored(TFT_eSPI *tft, int x, int y, int w, int h, uint16_t colour) {
+    tft->fillRect(x, y, w, h, colour);
+    FrameMirror::teeFill(tft, x, y, w, h, colour);
+}
+
+// text can't be copied as it's drawn; report its box to be read back instead
+static void notifyText(TFT_eSPI *tft, const char *text, int x, int y, int font,
+                       bool centred = true) {
+    int tw = tft->textWidth(text, font);
+    FrameMirror::notify(tft, centred ? x - tw / 2 : x, y, tw, tft->fontHeight(font));
+}
+
+static void runPixel(TFT_eSPI *tft, PixelRun &r, int x, int y, uint16_t c) {
+    // address windows aren't clipped, so drop off-screen pixels here
+    if (x < 0 || y < 0 || x >= tft->width() || y >= tft->height()) return;
+
+    if (r.len > 0 && r.len < AA_RUN_PIXELS) {
+        bool extendsRow = y == r.y && x == r.x + r.len;
+        bool extendsCol = x == r.x && y == r.y + r.len;
+        if (r.len == 1 && (extendsRow || extendsCol)) r.vertical = extendsCol;
+        if (r.vertical ? extendsCol : extendsRow) {
+            r.px[r.len++] = c;
+            return;
+        }
+    }
+    flushRun(tft, r);
+    r.x = x; r.y = y; r.vertical = false;
+    r.px[r.len++] = c;
+}
+
 // fractional part of x
 static float fpart(float x) { return x - floor(x); }
 // reverse fractional part
@@ -43,15 +139,44 @@ static uint16_t blendColor(uint16_t c1, uint16_t c2, float alpha) {
     return (r << 11) | (g << 5) | b;
 }
 
-// draw a pixel with blending against a fixed background colour
-static void blendPixel(TFT_eSPI *tft, int x, int y,
-                       uint16_t colour, uint16_t bg, float alpha) {
-    tft->drawPixel(x, y, blendColor(colour, bg, alpha));
+// readRect()/pushRect() keep colours byte-swapped relative to plain RGB565
+static inline uint16_t swap565(uint16_t c) { return (c >> 8) | (c << 8); }
+
+// where the anti-aliased helpers put their pixels: blended against a fixed
+// background and streamed to the panel in runs, into a block read back from
+// the panel so blending happens against what is really there, or into an
+// off-screen IndexedCanvas
+struct AATarget {
+    TFT_eSPI *tft;
+    uint16_t bg;
+    uint16_t *block;        // read-back pixels, nullptr for fixed-bg blending
+    int bx, by, bw, bh;     // area covered by block
+    PixelRun runs[2];       // one per Wu strand (pixel at floor / floor+1)
+    IndexedCanvas *canvas;  // off-screen target, bypasses all of the above
+};
+
+// draw a pixel of the given strand blended against the target's background
+static void blendPixel(AATarget &t, int strand, int x, int y,
+                       uint16_t colour, float alpha) {
+    if (t.canvas) {
+        t.canvas->blendPixel(x, y, colour, alpha);
+        return;
+    }
+    if (t.block) {
+        int i = x - t.bx;
+        int j = y - t.by;
+        if (i >= 0 && i < t.bw && j >= 0 && j < t.bh) {
+            uint16_t &dst = t.block[j * t.bw + i];
+            dst = swap565(blendColor(colour, swap565(dst), alpha));
+            return;
+        }
+    }
+    runPixel(t.tft, t.runs[strand], x, y, blendColor(colour, t.bg, alpha));
 }
 
 // Xiaolin Wu's anti‑aliased line algorithm adapted for 16‑bit TFT
-static void drawAALine(TFT_eSPI *tft, int x0, int y0, int x1, int y1,
-                        uint16_t colour, uint16_t bg) {
+static void rasterAALine(AATarget &t, int x0, int y0, int x1, int y1,
+                         uint16_t colour) {
     using std::swap; // bring std::swap into unqualified lookup for built-in types
     bool steep = abs(y1 - y0) > abs(x1 - x0);
     if (steep) { swap(x0, y0); swap(x1, y1); }
@@ -67,24 +192,31 @@ static void drawAALine(TFT_eSPI *tft, int x0, int y0, int x1, int y1,
     int xpxl1 = (int)xend;
     int ypxl1 = (int)floorf(yend);
     if (steep) {
-        blendPixel(tft, ypxl1,   xpxl1, colour, bg, rfpart(yend) * xgap);
-        blendPixel(tft, ypxl1+1, xpxl1, colour, bg, fpart(yend)  * xgap);
+        blendPixel(t, 0, ypxl1,   xpxl1, colour, rfpart(yend) * xgap);
+        blendPixel(t, 1, ypxl1+1, xpxl1, colour, fpart(yend)  * xgap);
     } else {
-        blendPixel(tft, xpxl1, ypxl1,   colour, bg, rfpart(yend) * xgap);
-        blendPixel(tft, xpxl1, ypxl1+1, colour, bg, fpart(yend)  * xgap);
+        blendPixel(t, 0, xpxl1, ypxl1,   colour, rfpart(yend) * xgap);
+        blendPixel(t, 1, xpxl1, ypxl1+1, colour, fpart(yend)  * xgap);
     }
-    float intery = yend + gradient;
-
-    // main loop
+    // main loop: the intersection is stepped as whole pixels plus a
+    // remainder in 1/dx, so a line's pixels don't depend on where it
+    // starts and a line moved one column over is drawn identically
+    int iy = y0, rem = 0;
+    int istep = dx == 0 ? 0 : dy / dx, rstep = dx == 0 ? 0 : dy % dx;
+    if (rstep < 0) { istep--; rstep += dx; }
+    float unit = dx == 0 ? 0.0f : 1.0f / dx;
     for (int x = xpxl1 + 1; x <= x1 - 1; x++) {
+        iy += istep;
+        rem += rstep;
+        if (rem >= dx) { rem -= dx; iy++; }
+        float f = rem * unit;
         if (steep) {
-            blendPixel(tft, (int)floorf(intery),   x, colour, bg, rfpart(intery));
-            blendPixel(tft, (int)floorf(intery)+1, x, colour, bg, fpart(intery));
+            blendPixel(t, 0, iy,   x, colour, 1.0f - f);
+            blendPixel(t, 1, iy+1, x, colour, f);
         } else {
-            blendPixel(tft, x, (int)floorf(intery),   colour, bg, rfpart(intery));
-            blendPixel(tft, x, (int)floorf(intery)+1, colour, bg, fpart(intery));
+            blendPixel(t, 0, x, iy,   colour, 1.0f - f);
+            blendPixel(t, 1, x, iy+1, colour, f);
         }
-        intery += gradient;
     }
 
     // last endpoint
@@ -94,14 +226,51 @@ static void drawAALine(TFT_eSPI *tft, int x0, int y0, int x1, int y1,
     int xpxl2 = (int)xend;
     int ypxl2 = (int)floorf(yend);
     if (steep) {
-        blendPixel(tft, ypxl2,   xpxl2, colour, bg, rfpart(yend) * xgap);
-        blendPixel(tft, ypxl2+1, xpxl2, colour, bg, fpart(yend)  * xgap);
+        blendPixel(t, 0, ypxl2,   xpxl2, colour, rfpart(yend) * xgap);
+        blendPixel(t, 1, ypxl2+1, xpxl2, colour, fpart(yend)  * xgap);
     } else {
-        blendPixel(tft, xpxl2, ypxl2,   colour, bg, rfpart(yend) * xgap);
-        blendPixel(tft, xpxl2, ypxl2+1, colour, bg, fpart(yend)  * xgap);
+        blendPixel(t, 0, xpxl2, ypxl2,   colour, rfpart(yend) * xgap);
+        blendPixel(t, 1, xpxl2, ypxl2+1, colour, fpart(yend)  * xgap);
     }
 }
 
+// anti-aliased line straight to the panel
+static void drawAALine(TFT_eSPI *tft, int x0, int y0, int x1, int y1,
+                        uint16_t colour, uint16_t bg) {
+    AATarget t;
+    t.tft = tft;
+    t.bg = bg;
+    t.block = nullptr;
+    t.canvas = nullptr;
+    t.runs[0].len = t.runs[1].len = 0;
+
+#if AA_USE_READPIXEL
+    // Wu's algorithm touches at most one pixel past the far end of the minor
+    // axis, so the line's bounding box grown by one covers every write
+    static uint16_t block[AA_READ_BLOCK_PIXELS];
+    int bx = min(x0, x1), by = min(y0, y1);
+    int bw = abs(x1 - x0) + 2, bh = abs(y1 - y0) + 2;
+    if (bw * bh <= AA_READ_BLOCK_PIXELS && bx >= 0 && by >= 0 &&
+        bx + bw <= tft->width() && by + bh <= tft->height()) {
+        readBlock(tft, bx, by, bw, bh, block);
+        t.block = block;
+        t.bx = bx; t.by = by; t.bw = bw; t.bh = bh;
+    }
+#endif
+
+    rasterAALine(t, x0, y0, x1, y1, colour);
+
+#if AA_USE_READPIXEL
+    if (t.block) {
+        tft->pushRect(t.bx, t.by, t.bw, t.bh, t.block);
+        FrameMirror::teeWindow(tft, t.bx, t.by, t.bw, t.bh);
+        FrameMirror::teePixels(tft, t.block, t.bw * t.bh, true);
+    }
+#endif
+    flushRun(tft, t.runs[0]);
+    flushRun(tft, t.runs[1]);
+}
+
 // draw an anti‑aliased rectangle outline
 static void drawRectAA(TFT_eSPI *tft, int x, int y, int w, int h,
                        uint16_t colour, uint16_t bg) {
@@ -111,43 +280,250 @@ static void drawRectAA(TFT_eSPI *tft, int x, int y, int w, int h,
     drawAALine(tft, x,     y + h - 1, x,     y,     colour, bg);
 }
 
-// draw a circle outline with a simple feather (two concentric rings)
-static void drawCircleAA(TFT_eSPI *tft, int cx, int cy, int r,
-                         uint16_t colour, uint16_t bg) {
-    tft->drawCircle(cx, cy, r, colour);
-    uint16_t fade = blendColor(colour, bg, 0.5f);
-    if (r + 1 > 0) tft->drawCircle(cx, cy, r + 1, fade);
-    if (r - 1 > 0) tft->drawCircle(cx, cy, r - 1, fade);
+
+// =======================
+//   INDEXED CANVAS
+// =======================
+
+// RGB565 pixels expanded per pushColors() call when pushing a canvas
+#ifndef CANVAS_PUSH_PIXELS
+#define CANVAS_PUSH_PIXELS 64
+#endif
+
+IndexedCanvas::IndexedCanvas(int width, int height, uint8_t bitsPerPixel) {
+    bpp = (bitsPerPixel == 4) ? 4 : 8;
+    w = width > 0 ? width : 0;
+    h = height > 0 ? height : 0;
+    stride = (w * bpp + 7) / 8;
+    paletteSize = 1 << bpp;
+    paletteUsed = 0;
+    palette = (uint16_t *)malloc(paletteSize * sizeof(uint16_t));
+    pixels = (uint8_t *)malloc((size_t)stride * h);
+    if (!palette || !pixels) {
+        free(palette);
+        free(pixels);
+        palette = nullptr;
+        pixels = nullptr;
+    }
+}
+
+IndexedCanvas::~IndexedCanvas() {
+    free(palette);
+    free(pixels);
+}
+
+uint8_t IndexedCanvas::colorIndex(uint16_t colour) {
+    for (int i = 0; i < paletteUsed; i++)
+        if (palette[i] == colour) return i;
+    if (paletteUsed < paletteSize) {
+        palette[paletteUsed] = colour;
+        return paletteUsed++;
+    }
+
+    // palette full: settle for the closest entry
+    int r = (colour >> 11) & 0x1F, g = (colour >> 5) & 0x3F, b = colour & 0x1F;
+    long best = 0x7FFFFFFF;
+    uint8_t bestIdx = 0;
+    for (int i = 0; i < paletteUsed; i++) {
+        int dr = ((palette[i] >> 11) & 0x1F) - r;
+        int dg = ((palette[i] >> 5)  & 0x3F) - g;
+        int db = ( palette[i]        & 0x1F) - b;
+        long d = 4L*dr*dr + (long)dg*dg + 4L*db*db;  // green has twice the steps
+        if (d < best) { best = d; bestIdx = i; }
+    }
+    return bestIdx;
+}
+
+void IndexedCanvas::setIndex(int x, int y, uint8_t index) {
+    uint8_t *p = pixels + y * stride;
+    if (bpp == 8) {
+        p[x] = index;
+    } else if (x & 1) {
+        p[x >> 1] = (p[x >> 1] & 0xF0) | (index & 0x0F);
+    } else {
+        p[x >> 1] = (p[x >> 1] & 0x0F) | (index << 4);
+    }
+}
+
+uint8_t IndexedCanvas::getIndex(int x, int y) const {
+    const uint8_t *p = pixels + y * stride;
+    if (bpp == 8) return p[x];
+    return (x & 1) ? (p[x >> 1] & 0x0F) : (p[x >> 1] >> 4);
+}
+
+void IndexedCanvas::clear(uint16_t colour) {
+    if (!valid()) return;
+    paletteUsed = 0;
+    uint8_t index = colorIndex(colour);
+    memset(pixels, bpp == 8 ? index : (index << 4) | index, (size_t)stride * h);
+}
+
+void IndexedCanvas::drawPixel(int x, int y, uint16_t colour) {
+    if (!valid() || x < 0 || y < 0 || x >= w || y >= h) return;
+    setIndex(x, y, colorIndex(colour));
+}
+
+void IndexedCanvas::fillRect(int x, int y, int rw, int rh, uint16_t colour) {
+    if (!valid()) return;
+    int x1 = min(x + rw, w), y1 = min(y + rh, h);
+    x = max(x, 0); y = max(y, 0);
+    uint8_t index = colorIndex(colour);
+    for (int j = y; j < y1; j++)
+        for (int i = x; i < x1; i++)
+            setIndex(i, j, index);
+}
+
+uint16_t IndexedCanvas::readPixel(int x, int y) const {
+    if (!valid() || x < 0 || y < 0 || x >= w || y >= h) return 0;
+    return palette[getIndex(x, y)];
+}
+
+void IndexedCanvas::blendPixel(int x, int y, uint16_t colour, float alpha) {
+    if (!valid() || x < 0 || y < 0 || x >= w || y >= h) return;
+    // a few coverage levels keep the AA ramps from eating the palette
+    float levels = (bpp == 4) ? 4.0f : 16.0f;
+    alpha = roundf(alpha * levels) / levels;
+    if (alpha <= 0.0f) return;
+    uint16_t dst = palette[getIndex(x, y)];
+    setIndex(x, y, colorIndex(blendColor(colour, dst, alpha)));
 }
 
-// helper that fills a circle and smooths its border
-static void fillCircleAA(TFT_eSPI *tft, int cx, int cy, int r,
-                         uint16_t colour, uint16_t bg) {
-    tft->fillCircle(cx, cy, r, colour);
-    drawCircleAA(tft, cx, cy, r, colour, bg);
+void IndexedCanvas::drawAALine(int x0, int y0, int x1, int y1, uint16_t colour) {
+    AATarget t;
+    t.tft = nullptr;
+    t.bg = 0;
+    t.block = nullptr;
+    t.canvas = this;
+    rasterAALine(t, x0, y0, x1, y1, colour);
+}
+
+void IndexedCanvas::push(TFT_eSPI *display, int x, int y) {
+    if (!valid()) return;
+
+    // clip against the screen, address windows aren't clipped
+    int sx = max(0, -x), sy = max(0, -y);
+    int ex = min(w, display->width() - x), ey = min(h, display->height() - y);
+    if (sx >= ex || sy >= ey) return;
+
+    static uint16_t line[CANVAS_PUSH_PIXELS];
+    WriteBatch batch(display);
+    display->setAddrWindow(x + sx, y + sy, ex - sx, ey - sy);
+    FrameMirror::teeWindow(display, x + sx, y + sy, ex - sx, ey - sy);
+    for (int j = sy; j < ey; j++) {
+        for (int i = sx; i < ex; i += CANVAS_PUSH_PIXELS) {
+            int n = min(CANVAS_PUSH_PIXELS, ex - i);
+            for (int k = 0; k < n; k++) line[k] = palette[getIndex(i + k, j)];
+            display->pushColors(line, n);
+            FrameMirror::teePixels(display, line, n);
+        }
+    }
 }
 
 
+// ---------------------
+//  Discs
+// ---------------------
+
+// whether a pixel d2 = dx² + dy² from a disc's centre is at most k whole
+// pixels out (its distance rounded); rings are one of these steps wide
+static bool inRing(long d2, int k) {
+    return k >= 0 && 4 * d2 < (long)(2 * k + 1) * (2 * k + 1);
+}
+
+// the end of a sweep clockwise from 3 o'clock, as a direction scaled to
+// whole numbers so pixels can be tested against it without trigonometry
+struct Sweep {
+    int ex, ey;
+    bool lowerHalf;   // the end lies in [pi, 2pi)
+    bool full;        // the sweep covers the whole turn
+};
+
+static bool lowerHalf(int dx, int dy) { return dy < 0 || (dy == 0 && dx < 0); }
+
+static Sweep sweepTo(float angle) {
+    Sweep s;
+    s.ex = (int)lroundf(cosf(angle) * 4096);
+    s.ey = (int)lroundf(sinf(angle) * 4096);
+    s.lowerHalf = lowerHalf(s.ex, s.ey);
+    s.full = angle >= radians(360) - 1e-4f;
+    return s;
+}
+
+// whether the angle of (dx, dy) lies in [0, the sweep's end): by half turn
+// first, then by which side of the end direction the pixel falls on
+static bool inSweep(const Sweep &s, int dx, int dy) {
+    if (s.full) return true;
+    bool lower = lowerHalf(dx, dy);
+    if (lower != s.lowerHalf) return !lower;
+    return (long)dx * s.ey - (long)dy * s.ex > 0;
+}
+
+// Paint every pixel within radius r of (cx, cy) with shade(dx, dy), a row
+// at a time in its own address window so nothing outside the disc is
+// touched. A disc is sent as its colours rather than as hundreds of
+// triangles and circles, which is also what lets a FrameMirror copy it.
+template <class Shade>
+static void pushDisc(TFT_eSPI *tft, int cx, int cy, int r, Shade shade) {
+    static uint16_t line[CANVAS_PUSH_PIXELS];
+    long lim = (long)(2 * r + 1) * (2 * r + 1);   // 4·dist² under this rounds to <= r
+    int y0 = max(cy - r, 0), y1 = min(cy + r, tft->height() - 1);
+    for (int y = y0; y <= y1; y++) {
+        int dy = y - cy;
+        int half = (int)sqrtf(max(0.0f, lim / 4.0f - dy * dy));
+        while (half > 0 && 4L * (half * half + dy * dy) >= lim) half--;
+        while (4L * ((half + 1) * (half + 1) + dy * dy) < lim) half++;
+
+        int xa = max(cx - half, 0), xb = min(cx + half, tft->width() - 1);
+        if (xa > xb) continue;
+        tft->setAddrWindow(xa, y, xb - xa + 1, 1);
+        FrameMirror::teeWindow(tft, xa, y, xb - xa + 1, 1);
+        for (int x = xa; x <= xb; x += CANVAS_PUSH_PIXELS) {
+            int n = min(CANVAS_PUSH_PIXELS, xb + 1 - x);
+            for (int k = 0; k < n; k++) line[k] = shade(x + k - cx, dy);
+            tft->pushColors(line, n);
+            FrameMirror::teePixels(tft, line, n);
+        }
+    }
+}
+
+
+// default labels for series/slices/bars created without names; kept as
+// string literals so no widget ever allocates a label on the heap
+static const char *const defaultNames[10] = {
+    "S1", "S2", "S3", "S4", "S5", "S6", "S7", "S8", "S9", "S10"
+};
+
+#if GRAPH_MAX_SERIES > 10
+#error "GRAPH_MAX_SERIES is at most 10"
+#endif
+
+// the build settings this library was compiled with (see GraphTFT.h)
+const char GRAPHTFT_LAYOUT = 0;
+
+
 // =======================
 //   LINE GRAPH (with scroll)
 // =======================
 Graph::Graph(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-             int ymin, int ymax, String graphTitle,
-             LegendPosition legend, int nSeries, String names[], uint16_t colors[],
-             uint16_t bg) {
+             int ymin, int ymax, const char *graphTitle,
+             LegendPosition legend, int nSeries, const char *names[], uint16_t colors[],
+             uint16_t bg, const char *) {
     
     tft = display;
     x = x0; y = y0; w = totalW; h = totalH;
     yMin = ymin; yMax = ymax;
     bgColor = bg;
     posX = 0;
-    seriesCount = nSeries;
-    title = graphTitle;
+    columnSeries = 0;
+    frameMode = false;
+    redrawDiffers = false;
+    seriesCount = constrain(nSeries, 0, GRAPH_MAX_SERIES);
+    title = graphTitle ? graphTitle : "";
     legendPos = legend;
 
     // Initialize series names and colors
     for (int i = 0; i < seriesCount; i++) {
-        seriesNames[i] = (names) ? names[i] : "S" + String(i+1);
+        seriesNames[i] = (names) ? names[i] : defaultNames[i];
         seriesColors[i] = (colors) ? colors[i] : TFT_GREEN;
     }
 
@@ -181,16 +557,23 @@ Graph::Graph(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
         for (int j = 0; j < plotW; j++)
             lastY[i][j] = plotY + plotH;
 
+    for (int i = 0; i < GRAPH_MAX_SERIES; i++) {
+        stats[i].mode = STAT_NONE;
+        resetStats(i);
+    }
+
     // Initial draw
+    WriteBatch batch(tft);
     drawBox();
     drawAxes();
     drawTitle();
     drawLegend();
+    FrameMirror::notify(tft, x, y, w, h);
 }
 
 void Graph::drawBox() {
     // background is solid; use normal fill
-    tft->fillRect(plotX, plotY, plotW, plotH, bgColor);
+    fillMirrored(tft, plotX, plotY, plotW, plotH, bgColor);
     // anti-aliased border makes the box edges softer
     drawRectAA(tft, plotX, plotY, plotW, plotH, TFT_WHITE, bgColor);
 }
@@ -201,7 +584,9 @@ void Graph::drawAxes(int yStep) {
         drawAALine(tft, plotX - 3, py, plotX, py, TFT_WHITE, bgColor);
         tft->setTextColor(TFT_WHITE, bgColor);
         tft->setTextSize(1);
-        tft->drawCentreString(String(v), plotX - 15, py - 4, 1);
+        char label[12];
+        snprintf(label, sizeof(label), "%d", v);
+        tft->drawCentreString(label, plotX - 15, py - 4, 1);
     }
 }
 
@@ -249,20 +634,122 @@ void Graph::drawLegend() {
 
 void Graph::plotPoint(int series, int value) {
     if (series < 0 || series >= seriesCount) return;
-    int py = map(value, yMin, yMax, plotY + plotH, plotY);
-    int px = plotX + posX;
+    frameMode = false;
+    WriteBatch batch(tft);
+    int py = valueRow(value);
 
-    // Draw line from previous point to current
-    if (posX > 0) {
+    // scrolling redraws every column in series order, once per series
+    if (columnSeries >> series) redrawDiffers = true;
+    lastY[series][posX] = py;
+
+    // overlays go underneath every series: the ones already drawn in this
+    // column are drawn again over it
+    if (statSample(series, posX, nullptr)) {
+        for (int i = 0; i < seriesCount; i++)
+            if (i != series && (columnSeries & (1UL << i))) drawSegment(i);
+    }
+    columnSeries |= 1UL << series;
+    drawSegment(series);
+}
+
+// line from a series' previous point to its point in column posX; like a
+// scroll's redraw, nothing joins a column the series wasn't plotted in
+void Graph::drawSegment(int series) {
+    int base = plotY + plotH;
+    if (posX > 0 && lastY[series][posX - 1] != base) {
         int pxPrev = plotX + posX - 1;
         int pyPrev = lastY[series][posX - 1];
-        drawAALine(tft, pxPrev, pyPrev, px, py, seriesColors[series], bgColor);
+        drawAALine(tft, pxPrev, pyPrev, plotX + posX, lastY[series][posX],
+                   seriesColors[series], bgColor);
     }
-    lastY[series][posX] = py;
+}
+
+// screen row of a reading; the row under the box marks columns without one,
+// so readings at or below yMin sit on the box's bottom edge
+int Graph::valueRow(int value) const {
+    int py = map(value, yMin, yMax, plotY + plotH, plotY);
+    return py < plotY + plotH ? py : plotY + plotH - 1;
+}
+
+// tallest plot (in pixels) plotFrame() can compose in its column buffer;
+// taller plots fall back to one plotPoint() per series
+#ifndef GRAPH_COLUMN_PIXELS
+#define GRAPH_COLUMN_PIXELS 320
+#endif
+
+// paint the vertical run y0..y1 into a column buffer starting at screen row
+// `top`, optionally feathering one pixel past each end
+static void paintSpan(uint16_t *column, int top, int n, int y0, int y1,
+                      uint16_t colour, bool feather) {
+    if (y0 > y1) std::swap(y0, y1);
+    for (int y = max(y0, top); y <= min(y1, top + n - 1); y++)
+        column[y - top] = colour;
+    if (!feather) return;
+    if (y0 - 1 >= top && y0 - 1 < top + n)
+        column[y0 - 1 - top] = blendColor(colour, column[y0 - 1 - top], 0.35f);
+    if (y1 + 1 >= top && y1 + 1 < top + n)
+        column[y1 + 1 - top] = blendColor(colour, column[y1 + 1 - top], 0.35f);
+}
+
+void Graph::plotFrame(const int values[]) {
+    int n = plotH - 2;
+    if (n <= 0) return;
+    if (n > GRAPH_COLUMN_PIXELS) {
+        for (int i = 0; i < seriesCount; i++) plotPoint(i, values[i]);
+        return;
+    }
+
+    frameMode = true;
+    for (int i = 0; i < seriesCount; i++)
+        lastY[i][posX] = valueRow(values[i]);
+
+    WriteBatch batch(tft);
+    composeColumn(posX, true);
+}
+
+// Compose one column of the plot in a buffer and push it with one window
+// write. It spans the rows inside the box's top and bottom edges; the side
+// columns start from the box's white edge instead of the background.
+void Graph::composeColumn(int col, bool withStats) {
+    static uint16_t column[GRAPH_COLUMN_PIXELS];
+    int top = plotY + 1;
+    int n = plotH - 2;
+    int base = plotY + plotH;
+    uint16_t under = (col == 0 || col == plotW - 1) ? TFT_WHITE : bgColor;
+    for (int k = 0; k < n; k++) column[k] = under;
+
+    // overlays first so they sit underneath every series
+    for (int i = 0; i < seriesCount && withStats; i++) {
+        int from, to;
+        if (!statUpdate(i, col, from, to)) continue;
+        if (stats[i].mode == STAT_BAND)
+            paintSpan(column, top, n, from, to,
+                      blendColor(seriesColors[i], bgColor, 0.25f), false);
+        else
+            paintSpan(column, top, n, from, to,
+                      blendColor(TFT_WHITE, seriesColors[i], 0.5f), true);
+    }
+
+    // each series covers the rows between its previous and current value;
+    // later series blend over earlier ones in the same buffer
+    for (int i = 0; i < seriesCount; i++) {
+        int py = lastY[i][col];
+        int prev = (col > 0) ? lastY[i][col - 1] : base;
+        int from = (prev == base) ? py : prev;
+        paintSpan(column, top, n, from, py, seriesColors[i], true);
+    }
+
+    int px = plotX + col;
+    tft->setAddrWindow(px, top, 1, n);
+    tft->pushColors(column, n);
+    FrameMirror::teeWindow(tft, px, top, 1, n);
+    FrameMirror::teePixels(tft, column, n);
 }
 
 void Graph::nextX() {
+    WriteBatch batch(tft);
     posX++;
+    columnSeries = 0;
     if (posX >= plotW) {
         // 🔹 Scroll mode: shift all data one pixel to the left
         for (int i = 0; i < seriesCount; i++) {
@@ -271,38 +758,500 @@ void Graph::nextX() {
             }
         }
 
-        // Clear plot area and redraw background (smoothing will happen in drawBox/axes)
-        drawBox();
-        drawAxes();
-        drawTitle();
-        drawLegend();
+        // without overlays the redraw below is the old picture moved one
+        // column left, so a mirror gets a scroll plus the columns that don't
+        // just move: the borders (AA lines spill one pixel) and the three
+        // newest. replayed statistics start over, so with overlays the whole
+        // redraw is sent instead, as is a canvas push or a redraw that
+        // differs from what plotPoint() drew (series out of order or
+        // plotted twice in a column).
+        bool composed = canvas && canvas->valid() && !frameMode;
+        bool scrolls = !composed && !redrawDiffers;
+        for (int i = 0; i < seriesCount; i++)
+            if (stats[i].mode != STAT_NONE) scrolls = false;
+        if (scrolls) {
+            // recomposed columns leave the box's top and bottom edges alone
+            int edge = frameMode ? 1 : 0;
+            FrameMirror::teeScroll(tft, plotX, plotY + edge, plotW, plotH - 2 * edge, -1);
+            FrameMirror::teeSkip(tft, plotX + 2, plotY, plotW - 5, plotH);
+        }
 
-        // Redraw all series with shifted data
-        for (int i = 0; i < seriesCount; i++) {
+        if (frameMode) {
+            // every column is recomposed the way plotFrame() drew it; the
+            // box edges, axes and legend around them stay as they are.
+            // Statistics are replayed up to the column before the newest.
+            for (int i = 0; i < seriesCount; i++)
+                if (stats[i].mode != STAT_NONE) resetStats(i);
+            for (int j = 0; j < plotW; j++) composeColumn(j, j < plotW - 1);
+        } else if (composed) {
+            // title, axes and legend don't move; only the plot is recomposed
+            redrawCanvas();
+        } else {
+            // Clear plot area and redraw background (smoothing will happen in drawBox/axes)
+            drawBox();
+            drawAxes();
+            drawTitle();
+            drawLegend();
+            replayStats(nullptr);
+
+            // Redraw all series with shifted data, column by column in the same
+            // order plotPoint() drew them
             for (int j = 1; j < plotW; j++) {
-                if (lastY[i][j-1] != plotY + plotH && lastY[i][j] != plotY + plotH) {
-                    drawAALine(tft,
-                               plotX + j - 1, lastY[i][j-1],
-                               plotX + j,     lastY[i][j],
-                               seriesColors[i], bgColor);
+                for (int i = 0; i < seriesCount; i++) {
+                    if (lastY[i][j-1] != plotY + plotH && lastY[i][j] != plotY + plotH) {
+                        drawAALine(tft,
+                                   plotX + j - 1, lastY[i][j-1],
+                                   plotX + j,     lastY[i][j],
+                                   seriesColors[i], bgColor);
+                    }
                 }
             }
         }
 
+        FrameMirror::teeSkip(tft, 0, 0, 0, 0);
+        redrawDiffers = false;
         posX = plotW - 1; // keep cursor at right edge
     }
 }
 
+void Graph::setCanvas(IndexedCanvas *c) { canvas = c; }
+
+void Graph::redrawCanvas() {
+    // same content as drawBox() + series redraw, composed off-screen so the
+    // plot is replaced in one push instead of being cleared and redrawn
+    canvas->clear(bgColor);
+    int r = plotW - 1, b = plotH - 1;
+    canvas->drawAALine(0, 0, r, 0, TFT_WHITE);
+    canvas->drawAALine(r, 0, r, b, TFT_WHITE);
+    canvas->drawAALine(r, b, 0, b, TFT_WHITE);
+    canvas->drawAALine(0, b, 0, 0, TFT_WHITE);
+    replayStats(canvas);
+
+    for (int i = 0; i < seriesCount; i++) {
+        for (int j = 1; j < plotW; j++) {
+            if (lastY[i][j-1] != plotY + plotH && lastY[i][j] != plotY + plotH) {
+                canvas->drawAALine(j - 1, lastY[i][j-1] - plotY,
+                                   j,     lastY[i][j]   - plotY,
+                                   seriesColors[i]);
+            }
+        }
+    }
+    canvas->push(tft, plotX, plotY);
+}
+
 void Graph::resetGraph() {
+    WriteBatch batch(tft);
     // 🔹 Completely clears and resets the graph (manual reset)
     drawBox();
     drawAxes();
     drawTitle();
     drawLegend();
+    FrameMirror::notify(tft, x, y, w, h);
     posX = 0;
-    for (int i = 0; i < seriesCount; i++)
+    columnSeries = 0;
+    redrawDiffers = false;
+    for (int i = 0; i < seriesCount; i++) {
         for (int j = 0; j < plotW; j++)
             lastY[i][j] = plotY + plotH;
+        resetStats(i);
+    }
+}
+
+// ---------------------
+//  Time-indexed mode
+// ---------------------
+
+void Graph::setTimeWindow(TimedSample *buffer, int capacity,
+                          uint32_t spanMs, uint32_t gapMs) {
+    timed = (capacity > 0) ? buffer : nullptr;
+    timedCap = capacity;
+    timedHead = 0;
+    timedCount = 0;
+    timeSpan = spanMs > 0 ? spanMs : 1;
+    timeGap = gapMs;
+}
+
+const TimedSample &Graph::timedAt(int i) const {
+    return timed[(timedHead - timedCount + i + timedCap) % timedCap];
+}
+
+void Graph::plotPoint(int series, int value, uint32_t timestamp) {
+    if (!timed || series < 0 || series >= seriesCount) return;
+    // keep the ring sorted so the window can be found by bisection;
+    // differences keep this correct across millis() wrap-around
+    if (timedCount > 0 && (int32_t)(timestamp - timedAt(timedCount - 1).t) < 0) return;
+
+    TimedSample &s = timed[timedHead];
+    s.t = timestamp;
+    s.value = value;
+    s.series = series;
+    timedHead = (timedHead + 1) % timedCap;
+    if (timedCount < timedCap) timedCount++;
+}
+
+void Graph::plotLine(IndexedCanvas *target, int x0, int y0, int x1, int y1,
+                     uint16_t colour) {
+    if (target) target->drawAALine(x0 - plotX, y0 - plotY, x1 - plotX, y1 - plotY, colour);
+    else        drawAALine(tft, x0, y0, x1, y1, colour, bgColor);
+}
+
+// a reading with no neighbour to join: a 3x3 dot, kept inside the box border
+void Graph::plotDot(IndexedCanvas *target, int x0, int y0, uint16_t colour) {
+    int left = max(x0 - 1, plotX + 1), right = min(x0 + 1, plotX + plotW - 2);
+    int top = max(y0 - 1, plotY + 1), bottom = min(y0 + 1, plotY + plotH - 2);
+    if (left > right || top > bottom) return;
+    if (target) target->fillRect(left - plotX, top - plotY, right - left + 1, bottom - top + 1, colour);
+    else        fillMirrored(tft, left, top, right - left + 1, bottom - top + 1, colour);
+}
+
+void Graph::updateTime(uint32_t now) {
+    if (!timed) return;
+    WriteBatch batch(tft);
+
+    IndexedCanvas *target = (canvas && canvas->valid()) ? canvas : nullptr;
+    if (target) {
+        target->clear(bgColor);
+        int r = plotW - 1, b = plotH - 1;
+        target->drawAALine(0, 0, r, 0, TFT_WHITE);
+        target->drawAALine(r, 0, r, b, TFT_WHITE);
+        target->drawAALine(r, b, 0, b, TFT_WHITE);
+        target->drawAALine(0, b, 0, 0, TFT_WHITE);
+    } else {
+        drawBox();
+    }
+
+    // first reading inside the window, by bisection over the sorted ring
+    uint32_t from = now - timeSpan;
+    int lo = 0, hi = timedCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if ((int32_t)(timedAt(mid).t - from) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // single pass: readings falling in the same column are averaged, and
+    // each finished column is joined to the previous one unless the gap
+    // between them is too long. A column joined on neither side is drawn
+    // as a dot once the next one (or the end) shows it stays alone.
+    int binCol[GRAPH_MAX_SERIES], binN[GRAPH_MAX_SERIES];
+    int prevCol[GRAPH_MAX_SERIES], prevY[GRAPH_MAX_SERIES];
+    long binSum[GRAPH_MAX_SERIES];
+    uint32_t binFirst[GRAPH_MAX_SERIES], binLast[GRAPH_MAX_SERIES], prevT[GRAPH_MAX_SERIES];
+    bool prevJoined[GRAPH_MAX_SERIES];
+    for (int i = 0; i < seriesCount; i++) { binN[i] = 0; prevCol[i] = -1; }
+
+    for (int i = lo; i <= timedCount; i++) {
+        bool done = (i == timedCount);
+        const TimedSample *s = done ? nullptr : &timedAt(i);
+        if (s && (int32_t)(s->t - now) > 0) done = true;   // newer than `now`
+
+        int col = 0;
+        if (!done) {
+            if (s->series >= seriesCount) continue;
+            col = (int)((float)(s->t - from) * (plotW - 1) / timeSpan);
+            int k = s->series;
+            if (binN[k] > 0 && binCol[k] == col) {
+                binSum[k] += s->value;
+                binN[k]++;
+                binLast[k] = s->t;
+                continue;
+            }
+        }
+
+        // flush the finished bin of this series (or of all, at the end)
+        int first = done ? 0 : s->series;
+        int last  = done ? seriesCount - 1 : s->series;
+        for (int k = first; k <= last; k++) {
+            if (binN[k] == 0) continue;
+            int v = binSum[k] / binN[k];
+            int px = plotX + binCol[k];
+            int py = map(v, yMin, yMax, plotY + plotH, plotY);
+            bool joins = prevCol[k] >= 0 && binFirst[k] - prevT[k] <= timeGap;
+            if (joins)
+                plotLine(target, plotX + prevCol[k], prevY[k], px, py, seriesColors[k]);
+            else if (prevCol[k] >= 0 && !prevJoined[k])
+                plotDot(target, plotX + prevCol[k], prevY[k], seriesColors[k]);
+            prevCol[k] = binCol[k];
+            prevY[k] = py;
+            prevT[k] = binLast[k];
+            prevJoined[k] = joins;
+            binN[k] = 0;
+        }
+        if (done) {
+            for (int k = 0; k < seriesCount; k++)
+                if (prevCol[k] >= 0 && !prevJoined[k])
+                    plotDot(target, plotX + prevCol[k], prevY[k], seriesColors[k]);
+            break;
+        }
+
+        int k = s->series;
+        binCol[k] = col;
+        binSum[k] = s->value;
+        binN[k] = 1;
+        binFirst[k] = binLast[k] = s->t;
+    }
+
+    if (target) target->push(tft, plotX, plotY);
+}
+
+// ---------------------
+//  Series statistics
+// ---------------------
+
+void Graph::P2Quantile::reset(float quantile) {
+    p = quantile;
+    count = 0;
+    for (int i = 0; i < 5; i++) n[i] = i;
+    np[0] = 0; np[1] = 2*p; np[2] = 4*p; np[3] = 2 + 2*p; np[4] = 4;
+}
+
+void Graph::P2Quantile::add(float v) {
+    // the first five samples seed the markers
+    if (count < 5) {
+        int i = count++;
+        while (i > 0 && q[i-1] > v) { q[i] = q[i-1]; i--; }
+        q[i] = v;
+        return;
+    }
+    count++;
+
+    int k;
+    if (v < q[0])       { q[0] = v; k = 0; }
+    else if (v >= q[4]) { q[4] = v; k = 3; }
+    else { k = 0; while (v >= q[k+1]) k++; }
+
+    const float dn[5] = { 0, p/2, p, (1+p)/2, 1 };
+    for (int i = k + 1; i < 5; i++) n[i]++;
+    for (int i = 0; i < 5; i++) np[i] += dn[i];
+
+    // nudge the middle markers towards their desired positions
+    for (int i = 1; i < 4; i++) {
+        float d = np[i] - n[i];
+        if ((d >= 1 && n[i+1] - n[i] > 1) || (d <= -1 && n[i-1] - n[i] < -1)) {
+            int ds = d > 0 ? 1 : -1;
+            float qp = q[i] + (float)ds / (n[i+1] - n[i-1]) *
+                       ((n[i] - n[i-1] + ds) * (q[i+1] - q[i]) / (n[i+1] - n[i]) +
+                        (n[i+1] - n[i] - ds) * (q[i] - q[i-1]) / (n[i] - n[i-1]));
+            if (q[i-1] < qp && qp < q[i+1])
+                q[i] = qp;                                              // parabolic
+            else
+                q[i] += ds * (q[i+ds] - q[i]) / (n[i+ds] - n[i]);      // linear
+            n[i] += ds;
+        }
+    }
+}
+
+float Graph::P2Quantile::value() const {
+    if (count == 0) return 0;
+    if (count < 5) return q[(int)(p * (count - 1) + 0.5f)];
+    return q[2];
+}
+
+void Graph::setOverlay(int series, SeriesStat stat, float param) {
+    if (series < 0 || series >= seriesCount) return;
+    if (stat == STAT_EMA && (param <= 0 || param > 1)) param = 0.1f;
+    if (stat == STAT_MEAN) param = constrain((int)param, 1, plotW - 1);
+    stats[series].mode = stat;
+    stats[series].param = param;
+    resetStats(series);
+}
+
+void Graph::resetStats(int series) {
+    SeriesStats &st = stats[series];
+    st.ema = 0;
+    st.sum = 0;
+    st.valid = 0;
+    st.col = -1;
+    st.count = 0;
+    st.prevY = 0;
+    st.lo.reset(0.05f);
+    st.hi.reset(0.95f);
+}
+
+bool Graph::statUpdate(int series, int col, int &from, int &to) {
+    SeriesStats &st = stats[series];
+    int base = plotY + plotH;
+    int py = lastY[series][col];
+    if (st.mode == STAT_NONE || py == base) return false;
+
+    int oy = 0;
+    switch (st.mode) {
+        case STAT_EMA:
+            st.ema = (st.count == 0) ? py : st.ema + st.param * (py - st.ema);
+            oy = (int)(st.ema + 0.5f);
+            break;
+        case STAT_MEAN: {
+            // running sum over the window; the column leaving it is still
+            // in lastY, so no separate history is needed. Anything but the
+            // next column (an overlay set on a graph with data, a series
+            // plotted twice in one column) sums the window afresh.
+            int win = (int)st.param;
+            if (col == st.col + 1) {
+                st.sum += py;
+                st.valid++;
+                if (col >= win && lastY[series][col - win] != base) {
+                    st.sum -= lastY[series][col - win];
+                    st.valid--;
+                }
+            } else {
+                st.sum = 0;
+                st.valid = 0;
+                for (int j = max(0, col - win + 1); j <= col; j++) {
+                    if (lastY[series][j] == base) continue;
+                    st.sum += lastY[series][j];
+                    st.valid++;
+                }
+            }
+            st.col = col;
+            if (st.valid <= 0) return false;
+            oy = (int)((st.sum + st.valid / 2) / st.valid);
+            break;
+        }
+        case STAT_BAND:
+            st.lo.add(py);
+            st.hi.add(py);
+            // smaller y is higher on screen: the 5th percentile of py is the top
+            from = (int)(st.lo.value() + 0.5f);
+            to   = (int)(st.hi.value() + 0.5f);
+            st.count++;
+            return true;
+        default:
+            break;
+    }
+    st.count++;
+
+    from = st.prevY;
+    to = oy;
+    st.prevY = oy;
+    return st.count > 1;
+}
+
+bool Graph::statSample(int series, int col, IndexedCanvas *target) {
+    int from, to;
+    if (!statUpdate(series, col, from, to)) return false;
+
+    // canvas coordinates are relative to the plot area
+    int sx = plotX + col;
+    int dx = target ? -plotX : 0;
+    int dy = target ? -plotY : 0;
+
+    if (stats[series].mode == STAT_BAND) {
+        uint16_t shade = blendColor(seriesColors[series], bgColor, 0.25f);
+        if (target) target->fillRect(sx + dx, from + dy, 1, to - from + 1, shade);
+        else        fillMirrored(tft, sx, from, 1, to - from + 1, shade);
+        return true;
+    }
+
+    uint16_t tint = blendColor(TFT_WHITE, seriesColors[series], 0.5f);
+    if (target) target->drawAALine(sx - 1 + dx, from + dy, sx + dx, to + dy, tint);
+    else        drawAALine(tft, sx - 1, from, sx, to, tint, bgColor);
+    return true;
+}
+
+void Graph::replayStats(IndexedCanvas *target) {
+    // after a scroll the statistics restart from the oldest visible column,
+    // so the overlays describe the history that is on screen
+    for (int i = 0; i < seriesCount; i++) {
+        if (stats[i].mode == STAT_NONE) continue;
+        resetStats(i);
+        for (int j = 0; j < plotW - 1; j++) statSample(i, j, target);
+    }
+}
+
+
+// =======================
+//   WATERFALL
+// =======================
+
+// default colormap stops: dark blue -> cyan -> green -> yellow -> red
+static const uint8_t waterfallStops[][3] = {
+    {0, 0, 48}, {0, 0, 255}, {0, 255, 255}, {0, 255, 0}, {255, 255, 0}, {255, 0, 0}
+};
+
+Waterfall::Waterfall(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
+                     float vmin, float vmax, int nBins,
+                     const char *graphTitle, uint16_t bg) {
+    tft = display;
+    x = x0; y = y0; w = totalW; h = totalH;
+    vMin = vmin;
+    scale = (vmax > vmin) ? (colormapSize - 1) / (vmax - vmin) : 0;
+    bins = nBins > 0 ? nBins : 1;
+    bgColor = bg;
+    title = graphTitle ? graphTitle : "";
+    row = 0;
+
+    if (!title[0]) titleSize = 0;
+    plotX = x;
+    plotY = y + titleSize;
+    plotW = w;
+    plotH = h - titleSize;
+
+    // interpolate the stops into the lookup table once
+    const int segments = sizeof(waterfallStops) / sizeof(waterfallStops[0]) - 1;
+    for (int i = 0; i < colormapSize; i++) {
+        float pos = (float)i * segments / (colormapSize - 1);
+        int s = min((int)pos, segments - 1);
+        float f = pos - s;
+        uint8_t c[3];
+        for (int k = 0; k < 3; k++)
+            c[k] = waterfallStops[s][k] + (waterfallStops[s+1][k] - waterfallStops[s][k]) * f;
+        colormap[i] = ((c[0] & 0xF8) << 8) | ((c[1] & 0xFC) << 3) | (c[2] >> 3);
+    }
+
+    resetWaterfall();
+}
+
+void Waterfall::setColormap(const uint16_t colors[], int count) {
+    if (count <= 0) return;
+    for (int i = 0; i < colormapSize; i++)
+        colormap[i] = colors[(long)i * (count - 1) / (colormapSize - 1)];
+}
+
+void Waterfall::drawTitle() {
+    if (title[0]) {
+        tft->setTextColor(TFT_WHITE, bgColor);
+        tft->setTextSize(1);
+        tft->drawCentreString(title, x + w/2, y, 2);
+    }
+}
+
+void Waterfall::resetWaterfall() {
+    WriteBatch batch(tft);
+    fillMirrored(tft, x, y, w, h, bgColor);
+    drawTitle();
+    if (title[0]) FrameMirror::notify(tft, x, y, w, titleSize);
+    row = 0;
+}
+
+void Waterfall::pushRow(const float values[]) {
+    if (plotW <= 0 || plotH <= 0) return;
+    WriteBatch batch(tft);
+
+    // one window for the whole row; each bin becomes a single colour run.
+    // bins narrower than a pixel share it and the strongest one wins.
+    int py = plotY + row;
+    tft->setAddrWindow(plotX, py, plotW, 1);
+    FrameMirror::teeWindow(tft, plotX, py, plotW, 1);
+    int startX = 0;
+    int level = 0;
+    for (int i = 0; i < bins; i++) {
+        int v = (int)((values[i] - vMin) * scale);
+        if (v < 0) v = 0;
+        if (v > colormapSize - 1) v = colormapSize - 1;
+        if (v > level) level = v;
+
+        int endX = (int)((long)(i + 1) * plotW / bins);
+        if (endX > startX) {
+            tft->pushColor(colormap[level], endX - startX);
+            FrameMirror::teeColour(tft, colormap[level], endX - startX);
+            startX = endX;
+            level = 0;
+        }
+    }
+
+    // sweep marker just below the newest row
+    row = (row + 1) % plotH;
+    fillMirrored(tft, plotX, plotY + row, plotW, 1, TFT_WHITE);
 }
 
 
@@ -310,20 +1259,20 @@ void Graph::resetGraph() {
 //   PIE CHART
 // =======================
 PieChart::PieChart(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-                   String graphTitle, LegendPosition legend,
-                   int nSeries, String names[], uint16_t colors[],
+                   const char *graphTitle, LegendPosition legend,
+                   int nSeries, const char *names[], uint16_t colors[],
                    uint16_t bg) {
     tft = display;
     x = x0; y = y0; w = totalW; h = totalH;
     bgColor = bg;
-    title = graphTitle;
+    title = graphTitle ? graphTitle : "";
     legendPos = legend;
     slices = nSeries;
     total = 0;
 
     // Initialize slices
     for (int i = 0; i < slices; i++) {
-        sliceLabels[i] = (names) ? names[i] : "S" + String(i+1);
+        sliceLabels[i] = (names) ? names[i] : defaultNames[i];
         sliceColors[i] = (colors) ? colors[i] : tft->color565(50*i, 100, 200);
         sliceValues[i] = 0;
     }
@@ -369,10 +1318,11 @@ void PieChart::setData(float values[]) {
 }
 
 void PieChart::drawTitle() {
-    if (title != "") {
+    if (title[0]) {
         tft->setTextColor(TFT_WHITE, bgColor);
         tft->setTextSize(1);
         tft->drawCentreString(title, x + w/2, y, 2);
+        notifyText(tft, title, x + w/2, y, 2);
     }
 }
 
@@ -387,11 +1337,12 @@ void PieChart::drawLegend() {
             int ly = (legendPos == LEGEND_TOP) ? y + titleSize : y + h - legendSize;
             for (int i = 0; i < slices; i++) {
                 int textW = tft->textWidth(sliceLabels[i]);
-                tft->fillRect(lx, ly, boxSize, boxSize, sliceColors[i]);
+                fillMirrored(tft, lx, ly, boxSize, boxSize, sliceColors[i]);
                 tft->setCursor(lx + boxSize + padding, ly);
                 tft->setTextColor(TFT_WHITE, bgColor);
                 tft->setTextSize(1);
                 tft->print(sliceLabels[i]);
+                notifyText(tft, sliceLabels[i], lx + boxSize + padding, ly, 1, false);
                 lx += boxSize + padding + textW + padding;
             }
             break;
@@ -401,11 +1352,12 @@ void PieChart::drawLegend() {
             for (int i = 0; i < slices; i++) {
                 int lx = (legendPos == LEGEND_LEFT) ? x + 2 : x + w - legendSize + 2;
                 int ly = y + titleSize + i*(h / slices);
-                tft->fillRect(lx, ly, boxSize, boxSize, sliceColors[i]);
+                fillMirrored(tft, lx, ly, boxSize, boxSize, sliceColors[i]);
                 tft->setCursor(lx + boxSize + 2, ly);
                 tft->setTextColor(TFT_WHITE, bgColor);
                 tft->setTextSize(1);
                 tft->print(sliceLabels[i]);
+                notifyText(tft, sliceLabels[i], lx + boxSize + 2, ly, 1, false);
             }
             break;
         }
@@ -413,27 +1365,28 @@ void PieChart::drawLegend() {
 }
 
 void PieChart::draw() {
-    tft->fillRect(x, y, w, h, bgColor);
+    WriteBatch batch(tft);
+    fillMirrored(tft, x, y, w, h, bgColor);
 
+    // where each slice ends, clockwise from 3 o'clock
+    Sweep end[10];
     float startAngle = 0;
     for (int i = 0; i < slices; i++) {
-        if (total <= 0) continue;
-        float angle = (sliceValues[i] / total) * 360.0;
-        float endAngle = startAngle + angle;
-
-        // Draw pie slice by filling triangles from center
-        for (float a = startAngle; a < endAngle; a += 1) {
-            float x1 = cx + r * cos(radians(a));
-            float y1 = cy + r * sin(radians(a));
-            float x2 = cx + r * cos(radians(a+1));
-            float y2 = cy + r * sin(radians(a+1));
-            tft->fillTriangle(cx, cy, x1, y1, x2, y2, sliceColors[i]);
-        }
-        startAngle = endAngle;
+        if (total > 0) startAngle += radians((sliceValues[i] / total) * 360.0);
+        end[i] = sweepTo(startAngle);
     }
 
-    // soften circumference
-    drawCircleAA(tft, cx, cy, r, TFT_WHITE, bgColor);
+    // slices inside a softened circumference: white on the radius, half
+    // white either side of it
+    uint16_t fade = blendColor(TFT_WHITE, bgColor, 0.5f);
+    pushDisc(tft, cx, cy, r + 1, [&](int dx, int dy) -> uint16_t {
+        long d2 = (long)dx * dx + (long)dy * dy;
+        if (!inRing(d2, r - 2))
+            return inRing(d2, r) && !inRing(d2, r - 1) ? TFT_WHITE : fade;
+        for (int i = 0; i < slices; i++)
+            if (inSweep(end[i], dx, dy)) return sliceColors[i];
+        return bgColor;
+    });
 
     drawTitle();
     drawLegend();
@@ -443,19 +1396,19 @@ void PieChart::draw() {
 //   BAR CHART
 // =======================
 BarChart::BarChart(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-                   String graphTitle, LegendPosition legend,
-                   int nSeries, String names[], uint16_t colors[],
+                   const char *graphTitle, LegendPosition legend,
+                   int nSeries, const char *names[], uint16_t colors[],
                    uint16_t bg) {
     tft = display;
     x = x0; y = y0; w = totalW; h = totalH;
     bgColor = bg;
-    title = graphTitle;
+    title = graphTitle ? graphTitle : "";
     legendPos = legend;
     bars = nSeries;
 
     // Initialize series names and colors
     for (int i = 0; i < bars; i++) {
-        barLabels[i] = (names) ? names[i] : "S" + String(i+1);
+        barLabels[i] = (names) ? names[i] : defaultNames[i];
         barColors[i] = (colors) ? colors[i] : TFT_BLUE;
         barValues[i] = 0;
     }
@@ -495,10 +1448,11 @@ void BarChart::setData(float values[]) {
 }
 
 void BarChart::drawTitle() {
-    if (title != "") {
+    if (title[0]) {
         tft->setTextColor(TFT_WHITE, bgColor);
         tft->setTextSize(1);
         tft->drawCentreString(title, x + w/2, y, 2);
+        notifyText(tft, title, x + w/2, y, 2);
     }
 }
 
@@ -513,11 +1467,12 @@ void BarChart::drawLegend() {
             int ly = (legendPos == LEGEND_TOP) ? y + titleSize : plotY + plotH + 2;
             for (int i = 0; i < bars; i++) {
                 int textW = tft->textWidth(barLabels[i]);
-                tft->fillRect(lx, ly, boxSize, boxSize, barColors[i]);
+                fillMirrored(tft, lx, ly, boxSize, boxSize, barColors[i]);
                 tft->setCursor(lx + boxSize + padding, ly);
                 tft->setTextColor(TFT_WHITE, bgColor);
                 tft->setTextSize(1);
                 tft->print(barLabels[i]);
+                notifyText(tft, barLabels[i], lx + boxSize + padding, ly, 1, false);
                 lx += boxSize + padding + textW + padding;
             }
             break;
@@ -527,11 +1482,12 @@ void BarChart::drawLegend() {
             for (int i = 0; i < bars; i++) {
                 int lx = (legendPos == LEGEND_LEFT) ? x + 2 : plotX + plotW + 2;
                 int ly = plotY + i*(plotH / bars);
-                tft->fillRect(lx, ly, boxSize, boxSize, barColors[i]);
+                fillMirrored(tft, lx, ly, boxSize, boxSize, barColors[i]);
                 tft->setCursor(lx + boxSize + 2, ly);
                 tft->setTextColor(TFT_WHITE, bgColor);
                 tft->setTextSize(1);
                 tft->print(barLabels[i]);
+                notifyText(tft, barLabels[i], lx + boxSize + 2, ly, 1, false);
             }
             break;
         }
@@ -539,8 +1495,9 @@ void BarChart::drawLegend() {
 }
 
 void BarChart::draw() {
+    WriteBatch batch(tft);
     // Clear plot
-    tft->fillRect(plotX, plotY, plotW, plotH, bgColor);
+    fillMirrored(tft, plotX, plotY, plotW, plotH, bgColor);
     drawRectAA(tft, plotX, plotY, plotW, plotH, TFT_WHITE, bgColor);
 
     if (maxValue <= 0) return;
@@ -549,18 +1506,21 @@ void BarChart::draw() {
     float scaleY = (float)plotH / maxValue;
 
     for (int i = 0; i < bars; i++) {
-        int barHeight = (int)(barValues[i] * scaleY);
+        float scaled = barValues[i] * scaleY;
+        int barHeight = scaled > 0 ? (int)scaled : 0;   // negatives sit on the axis
         int bx = plotX + i * barWidth + 2;
         int by = plotY + plotH - barHeight;
 
         // Draw bar
         // bars are solid, no AA needed on volume – edges softened by drawing small rectangles with background
-        tft->fillRect(bx, by, barWidth - 4, barHeight, barColors[i]);
+        fillMirrored(tft, bx, by, barWidth - 4, barHeight, barColors[i]);
 
         // ==========================
         // Draw value (with decimals)
         // ==========================
-        String valStr = String(barValues[i], 1); // 1 decimal place
+        // dtostrf has no length limit: room for -FLT_MAX (39 digits), ".d" and '\0'
+        char valStr[48];
+        dtostrf(barValues[i], 1, 1, valStr);    // 1 decimal place
         int textY = by - 12;                     // posição padrão (acima da barra)
 
         if (textY < plotY + 2) {
@@ -580,6 +1540,7 @@ void BarChart::draw() {
 
         tft->setTextSize(1);
         tft->drawCentreString(valStr, bx + (barWidth/2), textY, 1);
+        notifyText(tft, valStr, bx + (barWidth/2), textY, 1);
     }
 
     drawTitle();
@@ -619,44 +1580,41 @@ void Gauge::setValue(int value) {
     drawGauge();
 }
 
-static float _deg2rad(float d) { return d * 0.017453292519943295; }
-
 void Gauge::drawGauge() {
-    // clear area (outer circle + some margin) with smooth border
-    fillCircleAA(tft, cx, cy, radius + 2, bgColor, bgColor);
-
+    WriteBatch batch(tft);
     // compute angle span from -90 (top) clockwise
     float span = 0;
     if (maxVal > minVal) {
         span = ((float)(currValue - minVal) / (maxVal - minVal)) * 360.0;
     }
-    float start = -90;
-    float end = start + span;
-
-    // draw filled pie for progress
-    for (float a = start; a < end; a += 1.0) {
-        float x1 = cx + radius * cos(_deg2rad(a));
-        float y1 = cy + radius * sin(_deg2rad(a));
-        float x2 = cx + radius * cos(_deg2rad(a + 1));
-        float y2 = cy + radius * sin(_deg2rad(a + 1));
-        tft->fillTriangle(cx, cy, x1, y1, x2, y2, fgColor);
-    }
-
-    // soften outer edge of progress ring
-    drawCircleAA(tft, cx, cy, radius, fgColor, bgColor);
+    // measured from 12 o'clock: pixels are turned a quarter back to test
+    Sweep end = sweepTo(radians(span));
 
-    // mask center to create ring effect
+    // progress ring with softened edges, inside a margin cleared to bg
     int innerR = radius - thickness;
-    if (innerR > 0) {
-        fillCircleAA(tft, cx, cy, innerR, bgColor, fgColor);
-        // smooth inner boundary as well
-        drawCircleAA(tft, cx, cy, innerR, bgColor, fgColor);
-    }
+    uint16_t edge = blendColor(fgColor, bgColor, 0.5f);
+    uint16_t innerEdge = blendColor(bgColor, fgColor, 0.5f);
+    pushDisc(tft, cx, cy, radius + 3, [&](int dx, int dy) -> uint16_t {
+        long d2 = (long)dx * dx + (long)dy * dy;
+        if (!inRing(d2, radius + 1)) return bgColor;
+        if (!inRing(d2, radius - 2))
+            return inRing(d2, radius) && !inRing(d2, radius - 1) ? fgColor : edge;
+        if (innerR > 0 && inRing(d2, innerR + 1)) {
+            // mask center to create ring effect
+            if (!inRing(d2, innerR)) return innerEdge;         // innerR + 1
+            if (inRing(d2, innerR - 2) || !inRing(d2, innerR - 1)) return bgColor;
+            return innerEdge;                                   // innerR - 1
+        }
+        return inSweep(end, -dy, dx) ? fgColor : bgColor;
+    });
 
     // draw numeric value in center
     tft->setTextColor(fgColor, bgColor);
     tft->setTextSize(1);
-    tft->drawCentreString(String(currValue), cx, cy - 8, 4);
+    char valStr[12];
+    snprintf(valStr, sizeof(valStr), "%d", currValue);
+    tft->drawCentreString(valStr, cx, cy - 8, 4);
+    notifyText(tft, valStr, cx, cy - 8, 4);
 }
 
 
@@ -672,20 +1630,22 @@ void Gauge::drawGauge() {
 
 Card::Card(TFT_eSPI *display,
            int x0, int y0, int cardW, int cardH,
-           const String &title_,
+           const char *title_,
            uint16_t bg, uint16_t border, uint16_t text) :
     tft(display), x(x0), y(y0), w(cardW), h(cardH),
-    title(title_),
+    title(title_ ? title_ : ""),
     bgColor(bg), borderColor(border), textColor(text)
 {
 }
 
 void Card::draw() {
+    WriteBatch batch(tft);
+    FrameMirror::notify(tft, x, y, w, h);
     // draw rounded rect and header
     tft->fillRoundRect(x, y, w, h, 10, bgColor);
     tft->drawRoundRect(x, y, w, h, 10, borderColor);
 
-    if (title.length()) {
+    if (title[0]) {
         int tx = x + 10;
         int ty = y + 10;
         tft->setTextSize(1);
@@ -694,7 +1654,7 @@ void Card::draw() {
     }
 }
 
-void Card::setTitle(const String &t) { title = t; }
+void Card::setTitle(const char *t) { title = t ? t : ""; }
 void Card::setColors(uint16_t bg, uint16_t border, uint16_t text) {
     bgColor = bg;
     borderColor = border;
@@ -702,3 +1662,458 @@ void Card::setColors(uint16_t bg, uint16_t border, uint16_t text) {
 }
 
 
+// ---------------------
+//  Sparkline implementation
+// ---------------------
+
+Sparkline::Sparkline(TFT_eSPI *display,
+                     int x0, int y0, int cardW, int cardH,
+                     float vmin, float vmax,
+                     const char *title_, uint16_t line,
+                     uint16_t bg, uint16_t border, uint16_t text) :
+    Card(display, x0, y0, cardW, cardH, title_, bg, border, text),
+    head(0), count(0), markers(false), lineColor(line),
+    vMin(vmin), vMax(vmax > vmin ? vmax : vmin + 1)
+{
+}
+
+void Sparkline::draw() {
+    WriteBatch batch(tft);
+    Card::draw();
+    drawTrend();
+}
+
+void Sparkline::showMinMax(bool on) { markers = on; }
+
+void Sparkline::push(float value) {
+    float f = (value - vMin) / (vMax - vMin);
+    if (f < 0) f = 0;
+    if (f > 1) f = 1;
+    samples[head] = (uint8_t)(f * 255 + 0.5f);
+    head = (head + 1) % maxPoints;
+    if (count < maxPoints) count++;
+
+    WriteBatch batch(tft);
+    drawTrend();
+}
+
+void Sparkline::updateAll(Sparkline *lines[], const float values[], int n) {
+    for (int i = 0; i < n; i++)
+        if (lines[i]) lines[i]->push(values[i]);
+}
+
+void Sparkline::drawTrend() {
+    // plot area below the card header, clear of the rounded corners
+    int px = x + 8;
+    int py = y + (title[0] ? 26 : 10);
+    int pw = w - 16;
+    int ph = y + h - 10 - py;
+    if (pw < 2 || ph < 2) return;
+
+    fillMirrored(tft, px, py, pw, ph, bgColor);
+    if (count == 0) return;
+
+    int first = (head - count + maxPoints) % maxPoints;
+    int lo = 0, hi = 0;
+    int prevX = 0, prevY = 0;
+    for (int i = 0; i < count; i++) {
+        uint8_t v = samples[(first + i) % maxPoints];
+        int sx = px + (count > 1 ? i * (pw - 1) / (count - 1) : pw - 1);
+        int sy = py + ph - 1 - v * (ph - 1) / 255;
+        if (i > 0) drawAALine(tft, prevX, prevY, sx, sy, lineColor, bgColor);
+        if (v < samples[(first + lo) % maxPoints]) lo = i;
+        if (v > samples[(first + hi) % maxPoints]) hi = i;
+        prevX = sx; prevY = sy;
+    }
+
+    if (markers && count > 1) {
+        int idx[2] = { lo, hi };
+        uint16_t col[2] = { TFT_CYAN, TFT_RED };
+        for (int k = 0; k < 2; k++) {
+            uint8_t v = samples[(first + idx[k]) % maxPoints];
+            int sx = px + idx[k] * (pw - 1) / (count - 1);
+            int sy = py + ph - 1 - v * (ph - 1) / 255;
+            // keep the 3x3 marker inside the area cleared on each redraw
+            sx = constrain(sx, px + 1, px + pw - 2);
+            sy = constrain(sy, py + 1, py + ph - 2);
+            fillMirrored(tft, sx - 1, sy - 1, 3, 3, col[k]);
+        }
+    }
+}
+
+
+
+
+// =======================
+//   FRAME MIRROR
+// =======================
+
+// pixels read back from the panel per readRect while sending a frame
+#ifndef FRAME_MIRROR_LINE_PIXELS
+#define FRAME_MIRROR_LINE_PIXELS 320
+#endif
+
+FrameMirror *FrameMirror::active = nullptr;
+
+FrameMirror::FrameMirror(TFT_eSPI *display, Stream &stream, const char *) :
+    tft(display), out(&stream), readback(true),
+    dirtyCount(0), seenCount(0), lastCount(0), holeCount(0),
+    len(4), ops(0), dataAt(-1), dataRuns(0),
+    winX(0), winY(0), winW(0), winH(0), curX(0), curY(0), direct(false),
+    hostX(0), hostY(0), hostLeft(0), skipX(0), skipY(0), skipW(0), skipH(0)
+{
+}
+
+void FrameMirror::begin() {
+    active = this;
+    dirtyCount = seenCount = lastCount = holeCount = 0;
+    len = 4;
+    ops = 0;
+    dataAt = -1;
+    winW = winH = 0;
+    skipW = skipH = 0;
+    markDirty(0, 0, tft->width(), tft->height());
+}
+
+void FrameMirror::end() {
+    if (active == this) active = nullptr;
+}
+
+void FrameMirror::setReadback(bool on) {
+    readback = on;
+    if (!on) dirtyCount = seenCount = lastCount = 0;
+}
+
+void FrameMirror::notify(TFT_eSPI *display, int x, int y, int w, int h) {
+    if (active && active->tft == display) active->markDirty(x, y, w, h);
+}
+
+void FrameMirror::markDirty(int x, int y, int w, int h) {
+    if (!readback || !clip(x, y, w, h)) return;
+    addRect(dirty, dirtyCount, x, y, w, h);
+    if (skipW == 0) addRect(seen, seenCount, x, y, w, h);
+}
+
+// clip to the screen; false if nothing is left
+bool FrameMirror::clip(int &x, int &y, int &w, int &h) const {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > tft->width())  w = tft->width() - x;
+    if (y + h > tft->height()) h = tft->height() - y;
+    return w > 0 && h > 0;
+}
+
+void FrameMirror::addRect(Rect list[], int &count, int x, int y, int w, int h) {
+    // grow a region that already covers most of this one, else take a free
+    // slot; once the list is full, grow the region that grows least
+    int target = -1;
+    long best = 0x7FFFFFFF;
+    for (int i = 0; i < count; i++) {
+        const Rect &r = list[i];
+        long uw = max(x + w, r.x + r.w) - min(x, (int)r.x);
+        long uh = max(y + h, r.y + r.h) - min(y, (int)r.y);
+        long growth = uw * uh - (long)r.w * r.h;
+        if (growth < best) { best = growth; target = i; }
+    }
+    if ((target < 0 || best > (long)w * h / 2) && count < maxDirty) {
+        Rect &r = list[count++];
+        r.x = x; r.y = y; r.w = w; r.h = h;
+        return;
+    }
+
+    Rect &r = list[target];
+    int x1 = max(x + w, r.x + r.w);
+    int y1 = max(y + h, r.y + r.h);
+    r.x = min(x, (int)r.x);
+    r.y = min(y, (int)r.y);
+    r.w = x1 - r.x;
+    r.h = y1 - r.y;
+}
+
+// ---------------------
+//  Op buffer
+// ---------------------
+
+void FrameMirror::put16(int v) {
+    buf[len++] = (uint8_t)(v & 0xFF);
+    buf[len++] = (uint8_t)((v >> 8) & 0xFF);
+}
+
+void FrameMirror::closeData() {
+    if (dataAt < 0) return;
+    buf[dataAt]     = (uint8_t)(dataRuns & 0xFF);
+    buf[dataAt + 1] = (uint8_t)(dataRuns >> 8);
+    dataAt = -1;
+}
+
+// write out what's collected; the header is filled in now that the op
+// count is known, and space for the next one is kept at the front
+void FrameMirror::flush() {
+    closeData();
+    if (ops > 0) {
+        buf[0] = 'G';
+        buf[1] = 'F';
+        buf[2] = (uint8_t)(ops & 0xFF);
+        buf[3] = (uint8_t)(ops >> 8);
+        out->write(buf, len);
+    }
+    len = 4;
+    ops = 0;
+}
+
+// make room for n more bytes, sending the buffer early if it's full; the
+// host keeps its window, so pixel data simply continues in a new 'D' op
+void FrameMirror::room(int n) {
+    if (len + n > FRAME_MIRROR_BUFFER || ops == 0xFFFF) flush();
+}
+
+void FrameMirror::opWindow(int x, int y, int w, int h) {
+    closeData();
+    room(9);
+    buf[len++] = 'W';
+    put16(x); put16(y); put16(w); put16(h);
+    ops++;
+}
+
+void FrameMirror::opRect(char op, int x, int y, int w, int h, int v) {
+    closeData();
+    room(11);
+    buf[len++] = op;
+    put16(x); put16(y); put16(w); put16(h); put16(v);
+    ops++;
+}
+
+void FrameMirror::run(uint16_t colour, int n) {
+    while (n > 0) {
+        // extend the previous run when the colour repeats
+        if (dataAt >= 0 && dataRuns > 0 && buf[len - 3] < 255 &&
+            buf[len - 2] == (colour & 0xFF) && buf[len - 1] == (colour >> 8)) {
+            int k = min(n, 255 - buf[len - 3]);
+            buf[len - 3] += k;
+            n -= k;
+            continue;
+        }
+        room(6);
+        if (dataAt < 0 || dataRuns == 0xFFFF) {
+            closeData();
+            buf[len++] = 'D';
+            dataAt = len;
+            len += 2;
+            dataRuns = 0;
+            ops++;
+        }
+        int k = min(n, 255);
+        buf[len++] = (uint8_t)k;
+        put16(colour);
+        dataRuns++;
+        n -= k;
+    }
+}
+
+// ---------------------
+//  Copies of panel writes
+// ---------------------
+
+void FrameMirror::window(int x, int y, int w, int h) {
+    winX = x; winY = y; winW = w; winH = h;
+    curX = curY = 0;
+    hostLeft = 0;
+    int sx = x, sy = y, sw = w, sh = h;
+    if (skipW == 0 && clip(sx, sy, sw, sh)) addRect(seen, seenCount, sx, sy, sw, sh);
+    // the host gets the same window unless part of it must be left out
+    bool skipped = skipW > 0 && skipH > 0 &&
+                   x < skipX + skipW && skipX < x + w &&
+                   y < skipY + skipH && skipY < y + h;
+    direct = !skipped && w > 0 && h > 0 && x >= 0 && y >= 0 &&
+             x + w <= tft->width() && y + h <= tft->height();
+    if (direct) opWindow(x, y, w, h);
+}
+
+void FrameMirror::colour(uint16_t c, int n) {
+    if (winW <= 0 || winH <= 0) return;
+    if (direct) {
+        run(c, n);
+        return;
+    }
+
+    // clipped: send the visible part of each row, with a one-row host window
+    // wherever the visible pixels don't follow on from the last ones sent
+    while (n > 0) {
+        int px = winX + curX, py = winY + curY;
+        int k = min(n, winW - curX);
+        int take = k;
+        bool visible = py >= 0 && py < tft->height() && px < tft->width();
+        int end = min(winX + winW, tft->width());
+        int next;
+        if (visible && px < 0) {
+            visible = false;
+            take = min(k, -px);
+        } else if (visible && skipped(px, py, next)) {
+            visible = false;
+            take = min(k, next - px);
+        } else if (visible) {
+            end = min(end, next);
+        }
+        if (visible) {
+            take = min(k, end - px);
+            if (hostLeft <= 0 || hostX != px || hostY != py) {
+                opWindow(px, py, end - px, 1);
+                hostX = px; hostY = py; hostLeft = end - px;
+            }
+            run(c, take);
+            hostX += take;
+            hostLeft -= take;
+        }
+        curX += take;
+        n -= take;
+        if (curX == winW) {
+            curX = 0;
+            curY = (curY + 1) % winH;
+        }
+    }
+}
+
+void FrameMirror::fill(int x, int y, int w, int h, uint16_t c) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > tft->width())  w = tft->width() - x;
+    if (y + h > tft->height()) h = tft->height() - y;
+    if (w <= 0 || h <= 0) return;
+    if (skipW == 0) addRect(seen, seenCount, x, y, w, h);
+
+    int sx0 = max(x, skipX), sx1 = min(x + w, skipX + skipW);
+    int sy0 = max(y, skipY), sy1 = min(y + h, skipY + skipH);
+    if (sx0 >= sx1 || sy0 >= sy1) {
+        opRect('F', x, y, w, h, c);
+        return;
+    }
+    // the parts around the skipped area: above, below, left, right
+    if (sy0 > y)         opRect('F', x, y, w, sy0 - y, c);
+    if (sy1 < y + h)     opRect('F', x, sy1, w, y + h - sy1, c);
+    if (sx0 > x)         opRect('F', x, sy0, sx0 - x, sy1 - sy0, c);
+    if (sx1 < x + w)     opRect('F', sx1, sy0, x + w - sx1, sy1 - sy0, c);
+    // and whatever of it falls in the holes
+    for (int i = 0; i < holeCount; i++) {
+        const Rect &r = holes[i];
+        int hx0 = max(sx0, (int)r.x), hx1 = min(sx1, r.x + r.w);
+        int hy0 = max(sy0, (int)r.y), hy1 = min(sy1, r.y + r.h);
+        if (hx0 < hx1 && hy0 < hy1) opRect('F', hx0, hy0, hx1 - hx0, hy1 - hy0, c);
+    }
+}
+
+// whether (x, y) is left out of the copy, and the first column to its right
+// where that can change
+bool FrameMirror::skipped(int x, int y, int &next) const {
+    next = 0x7FFF;
+    if (y < skipY || y >= skipY + skipH || x >= skipX + skipW) return false;
+    if (x < skipX) {
+        next = skipX;
+        return false;
+    }
+    next = skipX + skipW;
+    bool out = true;
+    for (int i = 0; i < holeCount; i++) {
+        const Rect &r = holes[i];
+        if (y < r.y || y >= r.y + r.h) continue;
+        if (x >= r.x && x < r.x + r.w) {
+            out = false;
+            next = min(next, r.x + r.w);
+        } else if (x < r.x) {
+            next = min(next, (int)r.x);
+        }
+    }
+    return out;
+}
+
+void FrameMirror::teeWindow(TFT_eSPI *display, int x, int y, int w, int h) {
+    if (active && active->tft == display) active->window(x, y, w, h);
+}
+
+void FrameMirror::teePixels(TFT_eSPI *display, const uint16_t *px, int n, bool swapped) {
+    if (!active || active->tft != display) return;
+    int i = 0;
+    while (i < n) {
+        uint16_t c = px[i];
+        int k = 1;
+        while (i + k < n && px[i + k] == c) k++;
+        active->colour(swapped ? swap565(c) : c, k);
+        i += k;
+    }
+}
+
+void FrameMirror::teeColour(TFT_eSPI *display, uint16_t colour, int n) {
+    if (active && active->tft == display) active->colour(colour, n);
+}
+
+void FrameMirror::teeFill(TFT_eSPI *display, int x, int y, int w, int h, uint16_t colour) {
+    if (active && active->tft == display) active->fill(x, y, w, h, colour);
+}
+
+void FrameMirror::teeScroll(TFT_eSPI *display, int x, int y, int w, int h, int dx) {
+    if (active && active->tft == display) active->scroll(x, y, w, h, dx);
+}
+
+void FrameMirror::scroll(int x, int y, int w, int h, int dx) {
+    if (!clip(x, y, w, h)) return;
+    opRect('S', x, y, w, h, dx);
+
+    // whatever other widgets drew over the area last frame moved along with
+    // it on the host, while the panel gets the scrolled widget's own redraw
+    // there: keep sending that redraw over those regions, widened by the
+    // distance moved, until the skip is cleared
+    holeCount = 0;
+    for (int i = 0; i < lastCount; i++) {
+        int rx = last[i].x, rw = last[i].w;
+        if (dx < 0) rx += dx;
+        rw += abs(dx);
+        int x0 = max(rx, x), x1 = min(rx + rw, x + w);
+        int y0 = max((int)last[i].y, y), y1 = min(last[i].y + last[i].h, y + h);
+        if (x0 < x1 && y0 < y1) addRect(holes, holeCount, x0, y0, x1 - x0, y1 - y0);
+    }
+}
+
+void FrameMirror::teeSkip(TFT_eSPI *display, int x, int y, int w, int h) {
+    if (!active || active->tft != display) return;
+    FrameMirror *m = active;
+    bool on = w > 0 && h > 0;
+    m->skipX = on ? x : 0; m->skipY = on ? y : 0;
+    m->skipW = on ? w : 0; m->skipH = on ? h : 0;
+    if (!on) m->holeCount = 0;
+}
+
+// ---------------------
+//  Read-back regions
+// ---------------------
+
+void FrameMirror::sendFrame() {
+    for (int i = 0; i < dirtyCount; i++)
+        readRect(dirty[i].x, dirty[i].y, dirty[i].w, dirty[i].h);
+    dirtyCount = 0;
+    for (int i = 0; i < seenCount; i++) last[i] = seen[i];
+    lastCount = seenCount;
+    seenCount = 0;
+    flush();
+}
+
+void FrameMirror::readRect(int rx, int ry, int rw, int rh) {
+    static uint16_t line[FRAME_MIRROR_LINE_PIXELS];
+
+    opWindow(rx, ry, rw, rh);
+    // runs carry across row and chunk boundaries
+    for (int row = ry; row < ry + rh; row++) {
+        for (int cx = rx; cx < rx + rw; cx += FRAME_MIRROR_LINE_PIXELS) {
+            int n = min(FRAME_MIRROR_LINE_PIXELS, rx + rw - cx);
+            readBlock(tft, cx, row, n, 1, line);
+            int i = 0;
+            while (i < n) {
+                uint16_t c = line[i];
+                int k = 1;
+                while (i + k < n && line[i + k] == c) k++;
+                run(swap565(c), k);
+                i += k;
+            }
+        }
+    }
+    // the panel's window is gone; later pixel copies must set their own
+    winW = winH = 0;
+}
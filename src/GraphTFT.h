@@ -4,45 +4,311 @@
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 
+// Titles and labels are kept as pointers, never copied, so widgets do not
+// touch the heap after construction. Pass string literals (or buffers that
+// outlive the widget).
+
 enum LegendPosition { LEGEND_TOP, LEGEND_BOTTOM, LEGEND_LEFT, LEGEND_RIGHT };
 
+// one buffered reading for Graph's time-indexed mode
+struct TimedSample {
+    uint32_t t;         // timestamp, e.g. millis()
+    int16_t value;
+    uint8_t series;
+};
+
+// running statistic drawn over a Graph series (see Graph::setOverlay)
+enum SeriesStat { STAT_NONE, STAT_EMA, STAT_MEAN, STAT_BAND };
+
+// Settings that change the size of Graph and FrameMirror. The library and
+// every sketch file must see the same values, so set them as global build
+// flags (e.g. -DGRAPH_MAX_SERIES=8 in platformio.ini's build_flags or the
+// board's compiler.cpp.extra_flags), never with a #define before including
+// this header. Each must be a plain number.
+
+// series a Graph can hold (at most 10); each one costs 2 KB of history
+#ifndef GRAPH_MAX_SERIES
+#define GRAPH_MAX_SERIES 5
+#endif
+
+// bytes of ops a FrameMirror collects before writing them to its Stream
+#ifndef FRAME_MIRROR_BUFFER
+#define FRAME_MIRROR_BUFFER 2048
+#endif
+
+// Only GraphTFT.cpp defines this symbol, named after the values it was built
+// with. The constructors take its address at the caller, so a sketch built
+// with other values fails to link (undefined graphtftLayout_series…) instead
+// of corrupting memory.
+#define GRAPHTFT_LAYOUT_NAME(s, b) graphtftLayout_series##s##_mirror##b
+#define GRAPHTFT_LAYOUT_OF(s, b) GRAPHTFT_LAYOUT_NAME(s, b)
+#define GRAPHTFT_LAYOUT GRAPHTFT_LAYOUT_OF(GRAPH_MAX_SERIES, FRAME_MIRROR_BUFFER)
+extern const char GRAPHTFT_LAYOUT;
+
+
+// =======================
+//   INDEXED CANVAS
+// =======================
+// Off-screen buffer holding palette indices instead of RGB565 pixels: 4 bpp
+// (16 colours) or 8 bpp (256 colours). A 280x200 area needs 28 KB at 4 bpp
+// versus 112 KB as RGB565. Anti-aliased edges get their own palette entries
+// (quantised to a few levels); once the palette is full the closest existing
+// colour is used. Pixels are expanded back to RGB565 row by row while pushing.
+class IndexedCanvas {
+public:
+    /**
+     * @param width         canvas width in pixels
+     * @param height        canvas height in pixels
+     * @param bitsPerPixel  4 or 8
+     */
+    IndexedCanvas(int width, int height, uint8_t bitsPerPixel = 4);
+    ~IndexedCanvas();
+
+    IndexedCanvas(const IndexedCanvas &) = delete;
+    IndexedCanvas &operator=(const IndexedCanvas &) = delete;
+
+    /**
+     * false if the buffer could not be allocated
+     */
+    bool valid() const { return pixels != nullptr; }
+
+    int width() const { return w; }
+    int height() const { return h; }
+
+    /**
+     * Palette index for a colour, allocating a new entry if there is room
+     */
+    uint8_t colorIndex(uint16_t colour);
+
+    /**
+     * Forget all palette entries and fill the canvas with one colour
+     */
+    void clear(uint16_t colour);
+
+    void drawPixel(int x, int y, uint16_t colour);
+    void fillRect(int x, int y, int rw, int rh, uint16_t colour);
+    uint16_t readPixel(int x, int y) const;
+
+    /**
+     * Blend a colour over the pixel already in the canvas
+     */
+    void blendPixel(int x, int y, uint16_t colour, float alpha);
+
+    /**
+     * Anti-aliased line, blended against the canvas contents
+     */
+    void drawAALine(int x0, int y0, int x1, int y1, uint16_t colour);
+
+    /**
+     * Expand to RGB565 and send to the display with its top-left at (x, y)
+     */
+    void push(TFT_eSPI *display, int x, int y);
+
+private:
+    int w, h;
+    int stride;          // bytes per row
+    uint8_t bpp;
+    uint8_t *pixels;
+    uint16_t *palette;
+    int paletteSize;
+    int paletteUsed;
+
+    void setIndex(int x, int y, uint8_t index);
+    uint8_t getIndex(int x, int y) const;
+};
+
 // =======================
 //   LINE GRAPH
 // =======================
+
 class Graph {
 public:
     Graph(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-          int ymin, int ymax, String graphTitle,
+          int ymin, int ymax, const char *graphTitle,
           LegendPosition legend = LEGEND_RIGHT,
-          int nSeries = 1, String names[] = nullptr, uint16_t colors[] = nullptr,
-          uint16_t bg = TFT_BLACK);
+          int nSeries = 1, const char *names[] = nullptr, uint16_t colors[] = nullptr,
+          uint16_t bg = TFT_BLACK, const char *layout = &GRAPHTFT_LAYOUT);
 
     void plotPoint(int series, int value);
     void nextX();
     void resetGraph();
 
+    /**
+     * Plot one value per series for the current column in a single pass:
+     * all series (and overlays) are composed into a column buffer, later
+     * series blending over earlier ones, and pushed with one window write.
+     * Use instead of calling plotPoint() for every series; scrolling then
+     * recomposes the columns the same way.
+     */
+    void plotFrame(const int values[]);
+
+    /**
+     * Compose the plot off-screen when scrolling, replacing it in a single
+     * push. The canvas should be at least as large as the plot area;
+     * pass nullptr to draw straight to the display again.
+     */
+    void setCanvas(IndexedCanvas *c);
+
+    // size of the plot area, e.g. for sizing a canvas
+    int plotWidth() const { return plotW; }
+    int plotHeight() const { return plotH; }
+
+    /**
+     * Overlay a running statistic on a series, updated in O(1) per sample
+     * with constant memory:
+     *   STAT_EMA   exponential moving average, param = smoothing factor (0..1]
+     *   STAT_MEAN  mean of the last `param` samples
+     *   STAT_BAND  shaded band between the 5th and 95th percentiles
+     *              (P² estimates over the visible history)
+     * The overlay is drawn underneath the series in a lighter shade.
+     */
+    void setOverlay(int series, SeriesStat stat, float param = 0.1f);
+
+    /**
+     * Switch to time-indexed mode for sensors with irregular or missing
+     * readings. The plot shows the last `spanMs` milliseconds; readings of
+     * a series more than `gapMs` apart are drawn as a break instead of a
+     * line. `buffer` holds the readings of all series, oldest overwritten
+     * first, and must outlive the graph (e.g. a static array).
+     */
+    void setTimeWindow(TimedSample *buffer, int capacity,
+                       uint32_t spanMs, uint32_t gapMs);
+
+    /**
+     * Record a reading taken at `timestamp` (time-indexed mode only).
+     * Timestamps must not go backwards; older readings are ignored.
+     */
+    void plotPoint(int series, int value, uint32_t timestamp);
+
+    /**
+     * Redraw the time window ending at `now` (time-indexed mode only)
+     */
+    void updateTime(uint32_t now);
+
 private:
+    // P² streaming quantile estimator (Jain & Chlamtac): five markers
+    // instead of the sample history
+    struct P2Quantile {
+        float p;
+        float q[5];      // marker heights
+        float np[5];     // desired marker positions
+        int n[5];        // actual marker positions
+        int count;
+
+        void reset(float quantile);
+        void add(float v);
+        float value() const;
+    };
+
+    struct SeriesStats {
+        SeriesStat mode;
+        float param;
+        float ema;
+        long sum;        // STAT_MEAN: sum of the valid samples in the window
+        int valid;       // STAT_MEAN: how many samples are in the window
+        int col;         // STAT_MEAN: newest column in sum, -1 before any
+        int count;
+        int prevY;       // overlay y at the previous column
+        P2Quantile lo, hi;
+    };
+
     int x, y, w, h;
     int plotX, plotY, plotW, plotH;
     int yMin, yMax;
     uint16_t bgColor;
     TFT_eSPI *tft;
     int posX;
+    uint32_t columnSeries;   // bit per series already drawn in column posX
+    bool frameMode;          // drawn with plotFrame(), so scrolls recompose
+    bool redrawDiffers;      // a column drawn since the last scroll isn't
+                             // what the scroll's redraw will draw there
     int seriesCount;
-    String seriesNames[5];
-    uint16_t seriesColors[5];
-    int lastY[5][500];
-    String title;
+    const char *seriesNames[GRAPH_MAX_SERIES];
+    uint16_t seriesColors[GRAPH_MAX_SERIES];
+    int lastY[GRAPH_MAX_SERIES][500];
+    const char *title;
     LegendPosition legendPos;
 
     int titleSize = 20;
     int axisMargin = 20;
     int legendSize = 0;
 
+    IndexedCanvas *canvas = nullptr;
+    SeriesStats stats[GRAPH_MAX_SERIES];
+
+    // time-indexed mode: ring of readings, oldest first
+    TimedSample *timed = nullptr;
+    int timedCap = 0;
+    int timedHead = 0;   // next slot to write
+    int timedCount = 0;
+    uint32_t timeSpan = 0;
+    uint32_t timeGap = 0;
+
     void drawBox();
     void drawAxes(int yStep = 10);
     void drawTitle();
     void drawLegend();
+    void redrawCanvas();
+    void resetStats(int series);
+    bool statUpdate(int series, int col, int &from, int &to);
+    bool statSample(int series, int col, IndexedCanvas *target);
+    int valueRow(int value) const;
+    void drawSegment(int series);
+    void composeColumn(int col, bool withStats);
+    void replayStats(IndexedCanvas *target);
+    const TimedSample &timedAt(int i) const;
+    void plotLine(IndexedCanvas *target, int x0, int y0, int x1, int y1,
+                  uint16_t colour);
+    void plotDot(IndexedCanvas *target, int x0, int y0, uint16_t colour);
+};
+
+
+// =======================
+//   WATERFALL (scrolling heatmap)
+// =======================
+// One row of N values per update (FFT bins, sensor channels, ...), coloured
+// through a precomputed colormap and stretched across the widget. Rows sweep
+// top to bottom and wrap around, so every update costs one row of pixels in
+// a single address window, whatever the history length.
+class Waterfall {
+public:
+    /**
+     * @param vmin   value mapped to the first colormap entry
+     * @param vmax   value mapped to the last colormap entry
+     * @param nBins  values per row
+     */
+    Waterfall(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
+              float vmin, float vmax, int nBins,
+              const char *graphTitle = "", uint16_t bg = TFT_BLACK);
+
+    /**
+     * Draw the next row from nBins values
+     */
+    void pushRow(const float values[]);
+
+    /**
+     * Replace the colormap with `count` colours, lowest value first
+     */
+    void setColormap(const uint16_t colors[], int count);
+
+    void resetWaterfall();
+
+    static const int colormapSize = 64;
+
+private:
+    TFT_eSPI *tft;
+    int x, y, w, h;
+    int plotX, plotY, plotW, plotH;
+    float vMin, scale;
+    int bins;
+    int row;
+    uint16_t bgColor;
+    const char *title;
+    uint16_t colormap[colormapSize];
+
+    int titleSize = 20;
+
+    void drawTitle();
 };
 
 
@@ -52,9 +318,9 @@ private:
 class PieChart {
 public:
     PieChart(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-             String graphTitle,
+             const char *graphTitle,
              LegendPosition legend = LEGEND_RIGHT,
-             int nSeries = 1, String names[] = nullptr, uint16_t colors[] = nullptr,
+             int nSeries = 1, const char *names[] = nullptr, uint16_t colors[] = nullptr,
              uint16_t bg = TFT_BLACK);
 
     void setData(float values[]);
@@ -65,12 +331,12 @@ private:
     int x, y, w, h;       // full area
     int cx, cy, r;        // center and radius
     int slices;
-    String sliceLabels[10];
+    const char *sliceLabels[10];
     uint16_t sliceColors[10];
     float sliceValues[10];
     float total;
     uint16_t bgColor;
-    String title;
+    const char *title;
     LegendPosition legendPos;
 
     // Layout
@@ -88,9 +354,9 @@ private:
 class BarChart {
 public:
     BarChart(TFT_eSPI *display, int x0, int y0, int totalW, int totalH,
-             String graphTitle,
+             const char *graphTitle,
              LegendPosition legend = LEGEND_RIGHT,
-             int nSeries = 1, String names[] = nullptr, uint16_t colors[] = nullptr,
+             int nSeries = 1, const char *names[] = nullptr, uint16_t colors[] = nullptr,
              uint16_t bg = TFT_BLACK);
 
     void setData(float values[]);
@@ -101,12 +367,12 @@ private:
     int x, y, w, h;
     int plotX, plotY, plotW, plotH;
     int bars;
-    String barLabels[10];
+    const char *barLabels[10];
     uint16_t barColors[10];
     float barValues[10];
     float maxValue;
     uint16_t bgColor;
-    String title;
+    const char *title;
     LegendPosition legendPos;
 
     // Layout
@@ -165,7 +431,7 @@ class Card {
 public:
     Card(TFT_eSPI *display,
          int x0, int y0, int cardW, int cardH,
-         const String &title = "",
+         const char *title = "",
          uint16_t bg = TFT_BLACK, uint16_t border = TFT_WHITE,
          uint16_t text = TFT_WHITE);
 
@@ -175,16 +441,169 @@ public:
     // Card::draw() first when overriding
     virtual void draw();
 
-    void setTitle(const String &t);
+    void setTitle(const char *t);
     void setColors(uint16_t bg, uint16_t border, uint16_t text);
 
 protected:
     TFT_eSPI *tft;
     int x, y, w, h;
-    String title;
+    const char *title;
     uint16_t bgColor;
     uint16_t borderColor;
     uint16_t textColor;
 };
 
+
+// tiny trend line inside a card: no axes or legend, one byte per sample,
+// so dozens fit on one screen
+class Sparkline : public Card {
+public:
+    Sparkline(TFT_eSPI *display,
+              int x0, int y0, int cardW, int cardH,
+              float vmin = 0, float vmax = 100,
+              const char *title = "", uint16_t line = TFT_GREEN,
+              uint16_t bg = TFT_BLACK, uint16_t border = TFT_WHITE,
+              uint16_t text = TFT_WHITE);
+
+    void draw() override;
+
+    /**
+     * Append a sample (clamped to the range) and redraw the trend
+     */
+    void push(float value);
+
+    /**
+     * Mark the lowest and highest visible samples
+     */
+    void showMinMax(bool on);
+
+    /**
+     * Push one value into each sparkline, e.g. a whole grid per update;
+     * every cell is redrawn in a single transaction
+     */
+    static void updateAll(Sparkline *lines[], const float values[], int count);
+
+    static const int maxPoints = 32;
+
+private:
+    uint8_t samples[maxPoints];   // value scaled to 0..255
+    uint8_t head, count;
+    bool markers;
+    uint16_t lineColor;
+    float vMin, vMax;
+
+    void drawTrend();
+};
+
+
+// =======================
+//   FRAME MIRROR
+// =======================
+// Streams what the widgets draw to a host (e.g. a maintenance laptop) over a
+// Stream such as Serial. Widgets copy what they send to the panel into the
+// mirror as they draw it (pixel runs, fills, plot scrolls), so most of the
+// screen is never read back. Only text and whole-widget redraws (a graph
+// being reset, cards) are reported as changed regions that sendFrame() reads
+// back, which needs a panel with a working read path (MISO);
+// setReadback(false) skips them on panels without one. An idle screen costs
+// nothing.
+//
+// Wire format (all integers little endian):
+//   frame: 'G' 'F' u16 opCount, then opCount ops, applied in order
+//   'W' u16 x, y, w, h       set the write window, cursor at its top left
+//   'D' u16 runCount, runs   pixels at the cursor, row-major in the window;
+//                            each run is u8 length (1..255) + u16 RGB565
+//   'F' u16 x, y, w, h, colour   solid fill
+//   'S' u16 x, y, w, h, i16 dx   move the area's pixels dx columns (left
+//                                when negative); uncovered columns keep
+//                                their old content
+// The write window carries over from one frame to the next.
+// extras/mirror_decode.py decodes the stream on the host.
+
+class FrameMirror {
+public:
+    FrameMirror(TFT_eSPI *display, Stream &out, const char *layout = &GRAPHTFT_LAYOUT);
+
+    /**
+     * Start mirroring; the first frame sends the whole screen (read back)
+     */
+    void begin();
+
+    /**
+     * Stop receiving updates from the widgets
+     */
+    void end();
+
+    /**
+     * Mark an area as changed so it is read back (widgets do this for text;
+     * use it for anything drawn directly with TFT_eSPI)
+     */
+    void markDirty(int x, int y, int w, int h);
+
+    /**
+     * Read back changed regions (default) or drop them, for panels without
+     * MISO; everything else is still mirrored
+     */
+    void setReadback(bool on);
+
+    /**
+     * Send everything drawn since the last frame
+     */
+    void sendFrame();
+
+    // called by the widgets: regions to read back, and copies of what they
+    // send to the panel (window + pixels, fills, scrolls). teeSkip() names an
+    // area the host already has after a scroll, except where other widgets
+    // drew over it the frame before; a zero size clears it.
+    static void notify(TFT_eSPI *display, int x, int y, int w, int h);
+    static void teeWindow(TFT_eSPI *display, int x, int y, int w, int h);
+    static void teePixels(TFT_eSPI *display, const uint16_t *px, int n,
+                          bool swapped = false);
+    static void teeColour(TFT_eSPI *display, uint16_t colour, int n);
+    static void teeFill(TFT_eSPI *display, int x, int y, int w, int h, uint16_t colour);
+    static void teeScroll(TFT_eSPI *display, int x, int y, int w, int h, int dx);
+    static void teeSkip(TFT_eSPI *display, int x, int y, int w, int h);
+
+private:
+    static const int maxDirty = 16;
+    static FrameMirror *active;
+
+    struct Rect { int16_t x, y, w, h; };
+
+    TFT_eSPI *tft;
+    Stream *out;
+    bool readback;
+    Rect dirty[maxDirty];   // read back at the end of this frame
+    Rect seen[maxDirty];    // drawn in this frame, outside a skipped redraw
+    Rect last[maxDirty];    // and in the previous one
+    Rect holes[maxDirty];   // parts of the skipped area that are still sent
+    int dirtyCount, seenCount, lastCount, holeCount;
+
+    // ops are collected here and sent when full or at the end of a frame
+    uint8_t buf[FRAME_MIRROR_BUFFER];
+    int len, ops;
+    int dataAt, dataRuns;            // open 'D' op: offset of its count
+    int winX, winY, winW, winH;      // panel window and cursor within it
+    int curX, curY;
+    bool direct;                     // host window is the panel window
+    int hostX, hostY, hostLeft;      // host cursor while clipping
+    int skipX, skipY, skipW, skipH;
+
+    bool clip(int &x, int &y, int &w, int &h) const;
+    void addRect(Rect list[], int &count, int x, int y, int w, int h);
+    void scroll(int x, int y, int w, int h, int dx);
+    bool skipped(int x, int y, int &next) const;
+    void flush();
+    void put16(int v);
+    void closeData();
+    void room(int n);
+    void opWindow(int x, int y, int w, int h);
+    void opRect(char op, int x, int y, int w, int h, int v);
+    void run(uint16_t colour, int n);
+    void window(int x, int y, int w, int h);
+    void colour(uint16_t c, int n);
+    void fill(int x, int y, int w, int h, uint16_t c);
+    void readRect(int rx, int ry, int rw, int rh);
+};
+
 #endif